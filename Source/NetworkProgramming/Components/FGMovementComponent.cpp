@@ -34,9 +34,9 @@ void UFGMovementComponent::Move(FFGFrameMovement& FrameMovement)
 	FrameMovement.FinalLocation = UpdatedComponent->GetComponentLocation();
 }
 
-void UFGMovementComponent::ApplyGravity()
+void UFGMovementComponent::ApplyGravity(float DeltaTime)
 {
-	AccumulatedGravity += Gravity * GetWorld()->GetDeltaSeconds();
+	AccumulatedGravity += Gravity * DeltaTime;
 }
 
 void UFGMovementComponent::SetFacingRotation(const FRotator& InFacingRotation, float InRotationSpeed)
@@ -13,7 +13,7 @@ public:
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	FFGFrameMovement CreateFrameMovement() const;
 	void Move(FFGFrameMovement& FrameMovement);
-	void ApplyGravity();
+	void ApplyGravity(float DeltaTime);
 	UPROPERTY(EditAnywhere, Category = Movement)
 	float Gravity = 30.0f;
 	FVector GetGravityAsActor() const { return FVector(0.0f, 0.0f, AccumulatedGravity); }
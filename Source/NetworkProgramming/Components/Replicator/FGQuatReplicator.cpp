@@ -0,0 +1,39 @@
+#include "FGQuatReplicator.h"
+
+void UFGQuatReplicator::Tick(float DeltaTime)
+{
+	Core.Tick(*this, DeltaTime);
+}
+
+void UFGQuatReplicator::Init()
+{
+	Core.Init();
+}
+
+EFGReplicatorSendType UFGQuatReplicator::GatherSend(bool bIsDue)
+{
+	return Core.GatherSend(*this, bIsDue);
+}
+
+void UFGQuatReplicator::WriteValue(FArchive& Ar)
+{
+	Core.WriteValue(*this, Ar);
+}
+
+bool UFGQuatReplicator::ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal)
+{
+	return Core.ReceiveValue(*this, Ar, Batch, bIsTerminal);
+}
+
+void UFGQuatReplicator::SetValue(const FQuat& InValue)
+{
+	if (Core.SetValue(*this, InValue))
+	{
+		BroadcastDelegate();
+	}
+}
+
+FQuat UFGQuatReplicator::GetValue() const
+{
+	return Core.GetValue();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "FGReplicatorBase.h"
+#include "FGValueReplicatorCore.h"
+#include "FGQuatReplicator.generated.h"
+
+UCLASS()
+class NETWORKPROGRAMMING_API UFGQuatReplicator : public UFGReplicatorBase
+{
+	GENERATED_BODY()
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual void Init() override;
+	virtual EFGReplicatorSendType GatherSend(bool bIsDue) override;
+	virtual void WriteValue(FArchive& Ar) override;
+	virtual bool ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal) override;
+	void SetValue(const FQuat& InValue);
+	FQuat GetValue() const;
+private:
+	TFGValueReplicatorCore<FQuat> Core;
+};
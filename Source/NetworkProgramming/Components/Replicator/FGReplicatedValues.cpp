@@ -0,0 +1,99 @@
+#include "FGReplicatedValues.h"
+
+namespace
+{
+	const int32 QuatComponentBits = 15;
+	const uint32 QuatComponentMax = (1 << QuatComponentBits) - 1;
+	const float QuatComponentRange = 1.41421356f;
+
+	void SerializeSteps(FArchive& Ar, float& Value, float Step)
+	{
+		const int32 Quantized = FMath::RoundToInt(Value / Step);
+		uint32 Packed = static_cast<uint32>((Quantized << 1) ^ (Quantized >> 31));
+		Ar.SerializeIntPacked(Packed);
+		Value = static_cast<float>(static_cast<int32>(Packed >> 1) ^ -static_cast<int32>(Packed & 1)) * Step;
+	}
+
+	void SerializeCentimeters(FArchive& Ar, float& Value)
+	{
+		SerializeSteps(Ar, Value, 0.01f);
+	}
+}
+
+void FFGQuantizationPolicy::SerializeComponent(FArchive& Ar, float& Value) const
+{
+	if (Mode == EFGQuantizationMode::Step)
+	{
+		SerializeSteps(Ar, Value, FMath::Max(Step, KINDA_SMALL_NUMBER));
+		return;
+	}
+	const int32 Bits = FMath::Clamp(NumberBits, 1, 24);
+	const uint32 MaxQuantized = (1u << Bits) - 1;
+	const float RangeSize = FMath::Max(Max - Min, KINDA_SMALL_NUMBER);
+	uint32 Quantized = FMath::RoundToInt(FMath::Clamp((Value - Min) / RangeSize, 0.0f, 1.0f) * MaxQuantized);
+	Ar.SerializeInt(Quantized, MaxQuantized + 1);
+	Value = Min + RangeSize * static_cast<float>(FMath::Min(Quantized, MaxQuantized)) / static_cast<float>(MaxQuantized);
+}
+
+bool FFGReplicatedVector2D::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	SerializeCentimeters(Ar, Value.X);
+	SerializeCentimeters(Ar, Value.Y);
+	return true;
+}
+
+bool FFGReplicatedRotator::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	Value.SerializeCompressedShort(Ar);
+	return true;
+}
+
+bool FFGReplicatedQuat::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	float Components[4] = { Value.X, Value.Y, Value.Z, Value.W };
+	uint32 LargestIndex = 0;
+	if (Ar.IsSaving())
+	{
+		const FQuat Normalized = Value.GetNormalized();
+		Components[0] = Normalized.X;
+		Components[1] = Normalized.Y;
+		Components[2] = Normalized.Z;
+		Components[3] = Normalized.W;
+		for (uint32 Index = 1; Index < 4; ++Index)
+		{
+			if (FMath::Abs(Components[Index]) > FMath::Abs(Components[LargestIndex]))
+			{
+				LargestIndex = Index;
+			}
+		}
+		// q and -q are the same rotation, so the largest component can always be made positive and left out.
+		if (Components[LargestIndex] < 0.0f)
+		{
+			for (float& Component : Components)
+			{
+				Component = -Component;
+			}
+		}
+	}
+	Ar.SerializeBits(&LargestIndex, 2);
+	float SumSquared = 0.0f;
+	for (uint32 Index = 0; Index < 4; ++Index)
+	{
+		if (Index == LargestIndex)
+		{
+			continue;
+		}
+		// The smaller three can never be outside of +-1/sqrt(2).
+		const float Normalized = FMath::Clamp(Components[Index] / QuatComponentRange + 0.5f, 0.0f, 1.0f);
+		uint32 Quantized = static_cast<uint32>(FMath::RoundToInt(Normalized * QuatComponentMax));
+		Ar.SerializeBits(&Quantized, QuatComponentBits);
+		Components[Index] = ((static_cast<float>(Quantized & QuatComponentMax) / QuatComponentMax) - 0.5f) * QuatComponentRange;
+		SumSquared += FMath::Square(Components[Index]);
+	}
+	Components[LargestIndex] = FMath::Sqrt(FMath::Max(1.0f - SumSquared, 0.0f));
+	Value = FQuat(Components[0], Components[1], Components[2], Components[3]);
+	return true;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "FGReplicatedValues.generated.h"
+
+UENUM(BlueprintType)
+enum class EFGQuantizationMode : uint8
+{
+	Default,
+	Range,
+	Step
+};
+
+USTRUCT(BlueprintType)
+struct FFGQuantizationPolicy
+{
+	GENERATED_BODY()
+public:
+	void SerializeComponent(FArchive& Ar, float& Value) const;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	EFGQuantizationMode Mode = EFGQuantizationMode::Default;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	float Min = -1000.0f;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	float Max = 1000.0f;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1, ClampMax = 24))
+	int32 NumberBits = 16;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0.0001))
+	float Step = 0.01f;
+};
+
+USTRUCT()
+struct FFGReplicatedVector2D
+{
+	GENERATED_BODY()
+public:
+	FFGReplicatedVector2D() = default;
+	FFGReplicatedVector2D(const FVector2D& InValue) : Value(InValue) {}
+	operator FVector2D() const { return Value; }
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	UPROPERTY()
+	FVector2D Value = FVector2D::ZeroVector;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGReplicatedVector2D> : public TStructOpsTypeTraitsBase2<FFGReplicatedVector2D>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT()
+struct FFGReplicatedRotator
+{
+	GENERATED_BODY()
+public:
+	FFGReplicatedRotator() = default;
+	FFGReplicatedRotator(const FRotator& InValue) : Value(InValue) {}
+	operator FRotator() const { return Value; }
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	UPROPERTY()
+	FRotator Value = FRotator::ZeroRotator;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGReplicatedRotator> : public TStructOpsTypeTraitsBase2<FFGReplicatedRotator>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT()
+struct FFGReplicatedQuat
+{
+	GENERATED_BODY()
+public:
+	FFGReplicatedQuat() = default;
+	FFGReplicatedQuat(const FQuat& InValue) : Value(InValue) {}
+	operator FQuat() const { return Value; }
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	UPROPERTY()
+	FQuat Value = FQuat::Identity;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGReplicatedQuat> : public TStructOpsTypeTraitsBase2<FFGReplicatedQuat>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+template<typename ValueType>
+struct TFGReplicatedValueTraits;
+
+template<typename ValueType, typename PayloadType>
+struct TFGQuantizedValueTraits
+{
+	static ValueType GetDefault() { return ValueType(ForceInitToZero); }
+	static void NetSerialize(FArchive& Ar, ValueType& Value)
+	{
+		PayloadType Payload(Value);
+		bool bSuccess = true;
+		Payload.NetSerialize(Ar, nullptr, bSuccess);
+		Value = Payload;
+	}
+};
+
+template<>
+struct TFGReplicatedValueTraits<float>
+{
+	static float GetDefault() { return 0.0f; }
+	static void NetSerialize(FArchive& Ar, float& Value, const FFGQuantizationPolicy& Policy)
+	{
+		if (Policy.Mode == EFGQuantizationMode::Default)
+		{
+			Ar << Value;
+			return;
+		}
+		Policy.SerializeComponent(Ar, Value);
+	}
+	static float GetDistance(float A, float B) { return FMath::Abs(A - B); }
+};
+
+template<>
+struct TFGReplicatedValueTraits<FVector> : public TFGQuantizedValueTraits<FVector, FVector_NetQuantize100>
+{
+	using TFGQuantizedValueTraits::NetSerialize;
+	static void NetSerialize(FArchive& Ar, FVector& Value, const FFGQuantizationPolicy& Policy)
+	{
+		if (Policy.Mode == EFGQuantizationMode::Default)
+		{
+			NetSerialize(Ar, Value);
+			return;
+		}
+		Policy.SerializeComponent(Ar, Value.X);
+		Policy.SerializeComponent(Ar, Value.Y);
+		Policy.SerializeComponent(Ar, Value.Z);
+	}
+	static float GetDistance(const FVector& A, const FVector& B) { return FVector::Dist(A, B); }
+};
+
+template<>
+struct TFGReplicatedValueTraits<FVector2D> : public TFGQuantizedValueTraits<FVector2D, FFGReplicatedVector2D>
+{
+	using TFGQuantizedValueTraits::NetSerialize;
+	static void NetSerialize(FArchive& Ar, FVector2D& Value, const FFGQuantizationPolicy& Policy)
+	{
+		if (Policy.Mode == EFGQuantizationMode::Default)
+		{
+			NetSerialize(Ar, Value);
+			return;
+		}
+		Policy.SerializeComponent(Ar, Value.X);
+		Policy.SerializeComponent(Ar, Value.Y);
+	}
+	static float GetDistance(const FVector2D& A, const FVector2D& B) { return FVector2D::Distance(A, B); }
+};
+
+template<>
+struct TFGReplicatedValueTraits<FRotator> : public TFGQuantizedValueTraits<FRotator, FFGReplicatedRotator>
+{
+	using TFGQuantizedValueTraits::NetSerialize;
+	static void NetSerialize(FArchive& Ar, FRotator& Value, const FFGQuantizationPolicy& Policy)
+	{
+		if (Policy.Mode == EFGQuantizationMode::Default)
+		{
+			NetSerialize(Ar, Value);
+			return;
+		}
+		Policy.SerializeComponent(Ar, Value.Pitch);
+		Policy.SerializeComponent(Ar, Value.Yaw);
+		Policy.SerializeComponent(Ar, Value.Roll);
+	}
+	static float GetDistance(const FRotator& A, const FRotator& B)
+	{
+		const FRotator Delta = (A - B).GetNormalized();
+		return FMath::Max3(FMath::Abs(Delta.Pitch), FMath::Abs(Delta.Yaw), FMath::Abs(Delta.Roll));
+	}
+};
+
+template<>
+struct TFGReplicatedValueTraits<FQuat> : public TFGQuantizedValueTraits<FQuat, FFGReplicatedQuat>
+{
+	using TFGQuantizedValueTraits::NetSerialize;
+	static FQuat GetDefault() { return FQuat::Identity; }
+	static void NetSerialize(FArchive& Ar, FQuat& Value, const FFGQuantizationPolicy& Policy) { NetSerialize(Ar, Value); }
+	static float GetDistance(const FQuat& A, const FQuat& B) { return FMath::RadiansToDegrees(A.AngularDistance(B)); }
+};
@@ -79,6 +79,23 @@ bool UFGReplicatorBase::IsLocallyControlled() const
 	return ActorOuter && ActorOuter->HasAuthority();
 }
 
+float UFGReplicatorBase::GetCrumbDuration() const
+{
+	if (BatchCrumbDuration > 0.0f)
+	{
+		return BatchCrumbDuration;
+	}
+	return 1.0f / static_cast<float>(FMath::Max(NumberOfReplicationsPerSecond, 1));
+}
+
+void UFGReplicatorBase::BroadcastDelegate()
+{
+	if (OnValueChanged.IsBound())
+	{
+		OnValueChanged.Broadcast();
+	}
+}
+
 bool UFGReplicatorBase::HasAuthority() const
 {
 	if (!ensure(GetOuter() != nullptr))
@@ -2,21 +2,45 @@
 
 #include "UObject/Object.h"
 #include "Tickable.h"
+#include "FGReplicatedValues.h"
 #include "FGReplicatorBase.generated.h"
 
+struct FFGReplicatorBatch;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FFGOnSmoothValueReplicationChanged);
+
 UENUM()
 enum class EFGSmoothReplicatorMode : uint8
 {
-	ConstantVelocity
+	ConstantVelocity,
+	CubicHermite,
+	CatmullRom,
+	DeadReckoning
+};
+
+enum class EFGReplicatorSendType : uint8
+{
+	None,
+	Value,
+	Terminal
 };
 
-template<typename ValueType>
-struct TFGSmoothReplicatorOperation
+USTRUCT(BlueprintType)
+struct FFGJitterBufferStats
 {
-	static void InterpConstantVelocity(ValueType& CurrentValue, const ValueType& FrameTarget, float Alpha)
-	{
-		CurrentValue += (FrameTarget - CurrentValue) * Alpha;
-	}
+	GENERATED_BODY()
+	UPROPERTY(BlueprintReadOnly)
+	float BufferDepth = 0.0f;
+	UPROPERTY(BlueprintReadOnly)
+	float TargetDepth = 0.0f;
+	UPROPERTY(BlueprintReadOnly)
+	float Jitter = 0.0f;
+	UPROPERTY(BlueprintReadOnly)
+	float PlaybackRate = 1.0f;
+	UPROPERTY(BlueprintReadOnly)
+	int32 Underruns = 0;
+	UPROPERTY(BlueprintReadOnly)
+	int32 Overruns = 0;
 };
 
 UCLASS(abstract, BlueprintType, Blueprintable)
@@ -25,6 +49,9 @@ class NETWORKPROGRAMMING_API UFGReplicatorBase : public UObject, public FTickabl
 	GENERATED_BODY()
 public:
 	virtual void Init() {}
+	virtual EFGReplicatorSendType GatherSend(bool bIsDue) { return EFGReplicatorSendType::None; }
+	virtual void WriteValue(FArchive& Ar) {}
+	virtual bool ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal) { return false; }
 	virtual int32 GetFunctionCallspace(UFunction* Function, FFrame* Stack) override;
 	virtual bool CallRemoteFunction(UFunction* Function, void* Parms, struct FOutParmRec* OutParms, FFrame* Stack) override;
 	virtual bool IsSupportedForNetworking() const override;
@@ -36,6 +63,40 @@ public:
 	bool IsTicking() const;
 	bool IsLocallyControlled() const;
 	bool HasAuthority() const;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1))
+	int32 NumberOfReplicationsPerSecond = 5;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bAdaptiveReplicationRate = false;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1, EditCondition = "bAdaptiveReplicationRate"))
+	int32 MinNumberOfReplicationsPerSecond = 1;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, EditCondition = "bAdaptiveReplicationRate"))
+	float AdaptiveErrorTolerance = 1.0f;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0))
+	float Deadband = 0.0f;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	EFGSmoothReplicatorMode SmoothMode = EFGSmoothReplicatorMode::ConstantVelocity;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0))
+	float JitterBufferScale = 3.0f;
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 0, ClampMax = 0.9))
+	float MaxTimeStretch = 0.25f;
+	UPROPERTY(BlueprintAssignable)
+	FFGOnSmoothValueReplicationChanged OnValueChanged;
+	const FFGQuantizationPolicy& GetQuantization() const { return Quantization; }
+	float GetCrumbDuration() const;
+	void SetBatchCrumbDuration(float InBatchCrumbDuration) { BatchCrumbDuration = InBatchCrumbDuration; }
+	void SetBatchSendInterval(float InBatchSendInterval) { BatchSendInterval = InBatchSendInterval; }
+	float GetBatchSendInterval() const { return BatchSendInterval > 0.0f ? BatchSendInterval : GetCrumbDuration(); }
+	void BroadcastDelegate();
+	UFUNCTION(BlueprintPure, Category = Network)
+	const FFGJitterBufferStats& GetJitterBufferStats() const { return JitterBufferStats; }
+	void SetJitterBufferStats(const FFGJitterBufferStats& InJitterBufferStats) { JitterBufferStats = InJitterBufferStats; }
+protected:
+	// Not replicated, sender and receivers must agree on it, so it is only set on the class defaults.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
+	FFGQuantizationPolicy Quantization;
 private:
+	FFGJitterBufferStats JitterBufferStats;
 	bool bShouldTick = false;
+	float BatchCrumbDuration = 0.0f;
+	float BatchSendInterval = 0.0f;
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#include "FGReplicatorBatch.h"
+#include "Engine/NetSerialization.h"
+
+bool FFGReplicatorBatch::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	uint8 bShortSyncTag = bIsShortSyncTag ? 1 : 0;
+	Ar.SerializeBits(&bShortSyncTag, 1);
+	bIsShortSyncTag = (bShortSyncTag & 1) != 0;
+	uint32 PackedSyncTag = SyncTag;
+	Ar.SerializeInt(PackedSyncTag, 1u << GetSyncTagBits());
+	SyncTag = static_cast<uint16>(PackedSyncTag);
+	Ar << Timestamp;
+	Ar.SerializeIntPacked(ReplicatorMask);
+	uint32 PackedNumberBits = static_cast<uint32>(FMath::Clamp(NumberBits, 0, MaxBits));
+	Ar.SerializeIntPacked(PackedNumberBits);
+	if (Ar.IsLoading())
+	{
+		if (PackedNumberBits > static_cast<uint32>(MaxBits))
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		NumberBits = static_cast<int32>(PackedNumberBits);
+		Data.SetNumZeroed(FMath::DivideAndRoundUp(NumberBits, 8));
+	}
+	Ar.SerializeBits(Data.GetData(), NumberBits);
+	return true;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGReplicatorBatch.generated.h"
+
+USTRUCT()
+struct FFGReplicatorBatch
+{
+	GENERATED_BODY()
+public:
+	static const int32 MaxReplicators = 32;
+	static const int32 MaxBits = 8 * 1024;
+	static const int32 ShortSyncTagBits = 8;
+	static const int32 LongSyncTagBits = 16;
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	bool IsEmpty() const { return ReplicatorMask == 0; }
+	int32 GetSyncTagBits() const { return bIsShortSyncTag ? ShortSyncTagBits : LongSyncTagBits; }
+	// Newer if less than half the sequence space ahead of PreviousSyncTag.
+	static bool IsSyncTagNewer(uint16 InSyncTag, uint16 PreviousSyncTag, int32 NumberSyncTagBits)
+	{
+		const uint32 Difference = static_cast<uint32>(InSyncTag - PreviousSyncTag) & ((1u << NumberSyncTagBits) - 1);
+		return Difference != 0 && Difference < (1u << (NumberSyncTagBits - 1));
+	}
+	UPROPERTY()
+	uint16 SyncTag = 0;
+	static float GetTimestampDelta(uint16 InTimestamp, uint16 PreviousTimestamp)
+	{
+		return static_cast<float>(static_cast<uint16>(InTimestamp - PreviousTimestamp)) / 1000.0f;
+	}
+	UPROPERTY()
+	bool bIsShortSyncTag = false;
+	UPROPERTY()
+	uint16 Timestamp = 0;
+	UPROPERTY()
+	uint32 ReplicatorMask = 0;
+	UPROPERTY()
+	TArray<uint8> Data;
+	UPROPERTY()
+	int32 NumberBits = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGReplicatorBatch> : public TStructOpsTypeTraitsBase2<FFGReplicatorBatch>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
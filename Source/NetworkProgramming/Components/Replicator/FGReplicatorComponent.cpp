@@ -1,10 +1,32 @@
 #include "FGReplicatorComponent.h"
 #include "FGReplicatorBase.h"
 #include "Engine/ActorChannel.h"
+#include "GameFramework/Pawn.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
 
 UFGReplicatorComponent::UFGReplicatorComponent()
 {
 	SetIsReplicatedByDefault(true);
+	PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UFGReplicatorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (SmoothReplicators.Num() == 0 || !IsLocallyControlled())
+	{
+		return;
+	}
+	const float NetSendInterval = GetNetSendInterval();
+	NetSendTimer += DeltaTime;
+	if (NetSendTimer < NetSendInterval)
+	{
+		return;
+	}
+	NetSendTimer = FMath::Min(NetSendTimer - NetSendInterval, NetSendInterval);
+	FlushBatches();
+	NetTickIndex++;
 }
 
 bool UFGReplicatorComponent::ReplicateSubobjects(UActorChannel* Channel, FOutBunch* Bunch, FReplicationFlags* RepFlags)
@@ -16,8 +38,148 @@ bool UFGReplicatorComponent::ReplicateSubobjects(UActorChannel* Channel, FOutBun
 
 UFGReplicatorBase* UFGReplicatorComponent::AddReplicatorByClass(TSubclassOf<UFGReplicatorBase> ClassType, FName Name)
 {
+	if (!ensure(SmoothReplicators.Num() < FFGReplicatorBatch::MaxReplicators))
+	{
+		return nullptr;
+	}
 	UFGReplicatorBase* NewReplicator = NewObject<UFGReplicatorBase>(GetOwner(), ClassType, Name);
 	NewReplicator->Init();
 	SmoothReplicators.Add(NewReplicator);
 	return NewReplicator;
 }
+
+void UFGReplicatorComponent::Server_SendReplicatorBatch_Implementation(const FFGReplicatorBatch& Batch)
+{
+	if (IsLocallyControlled() || ApplyBatch(Batch, false))
+	{
+		Multicast_SendReplicatorBatch(Batch);
+	}
+}
+
+void UFGReplicatorComponent::Server_SendTerminalBatch_Implementation(const FFGReplicatorBatch& Batch)
+{
+	if (IsLocallyControlled() || ApplyBatch(Batch, true))
+	{
+		Multicast_SendTerminalBatch(Batch);
+	}
+}
+
+void UFGReplicatorComponent::Multicast_SendReplicatorBatch_Implementation(const FFGReplicatorBatch& Batch)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		ApplyBatch(Batch, false);
+	}
+}
+
+void UFGReplicatorComponent::Multicast_SendTerminalBatch_Implementation(const FFGReplicatorBatch& Batch)
+{
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		ApplyBatch(Batch, true);
+	}
+}
+
+void UFGReplicatorComponent::FlushBatches()
+{
+	const float NetSendInterval = GetNetSendInterval();
+	FFGReplicatorBatch ValueBatch;
+	FFGReplicatorBatch TerminalBatch;
+	FBitWriter ValueWriter(0, true);
+	FBitWriter TerminalWriter(0, true);
+	for (int32 Index = 0; Index < SmoothReplicators.Num(); ++Index)
+	{
+		UFGReplicatorBase* Replicator = SmoothReplicators[Index];
+		if (Replicator == nullptr)
+		{
+			continue;
+		}
+		const int32 NetTicksPerSend = GetNetTicksPerSend(Replicator);
+		Replicator->SetBatchCrumbDuration(NetSendInterval * NetTicksPerSend);
+		const EFGReplicatorSendType SendType = Replicator->GatherSend(NetTickIndex % NetTicksPerSend == 0);
+		if (SendType == EFGReplicatorSendType::Value)
+		{
+			ValueBatch.ReplicatorMask |= 1u << Index;
+			Replicator->WriteValue(ValueWriter);
+		}
+		else if (SendType == EFGReplicatorSendType::Terminal)
+		{
+			TerminalBatch.ReplicatorMask |= 1u << Index;
+			Replicator->WriteValue(TerminalWriter);
+		}
+	}
+	if (ValueBatch.IsEmpty() && TerminalBatch.IsEmpty())
+	{
+		return;
+	}
+	ValueBatch.bIsShortSyncTag = bUseShortSyncTags;
+	TerminalBatch.bIsShortSyncTag = bUseShortSyncTags;
+	const uint16 Timestamp = static_cast<uint16>(FMath::FloorToInt(GetWorld()->GetTimeSeconds() * 1000.0f) & 0xFFFF);
+	ValueBatch.Timestamp = Timestamp;
+	TerminalBatch.Timestamp = Timestamp;
+	const uint16 SyncTag = NextSyncTag;
+	NextSyncTag = (NextSyncTag + 1) & ((1u << ValueBatch.GetSyncTagBits()) - 1);
+	if (!ValueBatch.IsEmpty())
+	{
+		ValueBatch.SyncTag = SyncTag;
+		ValueBatch.Data = *ValueWriter.GetBuffer();
+		ValueBatch.NumberBits = ValueWriter.GetNumBits();
+		Server_SendReplicatorBatch(ValueBatch);
+	}
+	if (!TerminalBatch.IsEmpty())
+	{
+		TerminalBatch.SyncTag = SyncTag;
+		TerminalBatch.Data = *TerminalWriter.GetBuffer();
+		TerminalBatch.NumberBits = TerminalWriter.GetNumBits();
+		Server_SendTerminalBatch(TerminalBatch);
+	}
+}
+
+bool UFGReplicatorComponent::ApplyBatch(const FFGReplicatorBatch& Batch, bool bIsTerminal)
+{
+	if (IsLocallyControlled())
+	{
+		return false;
+	}
+	bool bAccepted = false;
+	const float NetSendInterval = GetNetSendInterval();
+	FBitReader Reader(const_cast<uint8*>(Batch.Data.GetData()), Batch.NumberBits);
+	for (int32 Index = 0; Index < SmoothReplicators.Num() && !Reader.IsError(); ++Index)
+	{
+		if ((Batch.ReplicatorMask & (1u << Index)) == 0)
+		{
+			continue;
+		}
+		UFGReplicatorBase* Replicator = SmoothReplicators[Index];
+		// Without the replicator there is no telling how many bits its value used.
+		if (!ensure(Replicator != nullptr))
+		{
+			return bAccepted;
+		}
+		Replicator->SetBatchCrumbDuration(NetSendInterval * GetNetTicksPerSend(Replicator));
+		Replicator->SetBatchSendInterval(NetSendInterval);
+		bAccepted |= Replicator->ReceiveValue(Reader, Batch, bIsTerminal);
+	}
+	return bAccepted;
+}
+
+float UFGReplicatorComponent::GetNetSendInterval() const
+{
+	return 1.0f / static_cast<float>(FMath::Max(NumberOfSendsPerSecond, 1));
+}
+
+int32 UFGReplicatorComponent::GetNetTicksPerSend(const UFGReplicatorBase* Replicator) const
+{
+	const float NetTicks = static_cast<float>(NumberOfSendsPerSecond) / static_cast<float>(FMath::Max(Replicator->NumberOfReplicationsPerSecond, 1));
+	return FMath::Max(FMath::RoundToInt(NetTicks), 1);
+}
+
+bool UFGReplicatorComponent::IsLocallyControlled() const
+{
+	if (const APawn* PawnOwner = Cast<APawn>(GetOwner()))
+	{
+		return PawnOwner->IsLocallyControlled();
+	}
+	const AActor* ActorOwner = GetOwner();
+	return ActorOwner != nullptr && ActorOwner->HasAuthority();
+}
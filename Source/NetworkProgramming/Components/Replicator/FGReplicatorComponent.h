@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Components//ActorComponent.h"
+#include "FGReplicatorBatch.h"
 #include "FGReplicatorComponent.generated.h"
 
 class UFGReplicatorBase;
@@ -11,6 +12,7 @@ class NETWORKPROGRAMMING_API UFGReplicatorComponent : public UActorComponent
 	GENERATED_BODY()
 public:
 	UFGReplicatorComponent();
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Smooth Replicator"))
 	UFGReplicatorBase* AddReplicatorByClass(TSubclassOf<UFGReplicatorBase> ClassType, FName Name);
@@ -19,7 +21,29 @@ public:
 	{
 		return CastChecked<ClassType>(AddReplicatorByClass(ClassType::StaticClass(), Name));
 	}
+	UFUNCTION(Server, Unreliable)
+	void Server_SendReplicatorBatch(const FFGReplicatorBatch& Batch);
+	UFUNCTION(Server, Reliable)
+	void Server_SendTerminalBatch(const FFGReplicatorBatch& Batch);
+	UFUNCTION(NetMulticast, Unreliable)
+	void Multicast_SendReplicatorBatch(const FFGReplicatorBatch& Batch);
+	UFUNCTION(NetMulticast, Reliable)
+	void Multicast_SendTerminalBatch(const FFGReplicatorBatch& Batch);
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1))
+	int32 NumberOfSendsPerSecond = 10;
+	// 8 bit sync tags instead of 16, they wrap after 256 sends which receivers handle as long as packets are not
+	// delayed by more than half of that.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bUseShortSyncTags = false;
 private:
+	void FlushBatches();
+	bool ApplyBatch(const FFGReplicatorBatch& Batch, bool bIsTerminal);
+	float GetNetSendInterval() const;
+	int32 GetNetTicksPerSend(const UFGReplicatorBase* Replicator) const;
+	bool IsLocallyControlled() const;
 	UPROPERTY()
 	TArray<UFGReplicatorBase*> SmoothReplicators;
-};
\ No newline at end of file
+	float NetSendTimer = 0.0f;
+	uint32 NetTickIndex = 0;
+	uint16 NextSyncTag = 0;
+};
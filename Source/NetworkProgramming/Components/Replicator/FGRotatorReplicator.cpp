@@ -0,0 +1,39 @@
+#include "FGRotatorReplicator.h"
+
+void UFGRotatorReplicator::Tick(float DeltaTime)
+{
+	Core.Tick(*this, DeltaTime);
+}
+
+void UFGRotatorReplicator::Init()
+{
+	Core.Init();
+}
+
+EFGReplicatorSendType UFGRotatorReplicator::GatherSend(bool bIsDue)
+{
+	return Core.GatherSend(*this, bIsDue);
+}
+
+void UFGRotatorReplicator::WriteValue(FArchive& Ar)
+{
+	Core.WriteValue(*this, Ar);
+}
+
+bool UFGRotatorReplicator::ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal)
+{
+	return Core.ReceiveValue(*this, Ar, Batch, bIsTerminal);
+}
+
+void UFGRotatorReplicator::SetValue(const FRotator& InValue)
+{
+	if (Core.SetValue(*this, InValue))
+	{
+		BroadcastDelegate();
+	}
+}
+
+FRotator UFGRotatorReplicator::GetValue() const
+{
+	return Core.GetValue();
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "FGReplicatorBase.h"
+#include "FGValueReplicatorCore.h"
+#include "FGRotatorReplicator.generated.h"
+
+UCLASS()
+class NETWORKPROGRAMMING_API UFGRotatorReplicator : public UFGReplicatorBase
+{
+	GENERATED_BODY()
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual void Init() override;
+	virtual EFGReplicatorSendType GatherSend(bool bIsDue) override;
+	virtual void WriteValue(FArchive& Ar) override;
+	virtual bool ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal) override;
+	UFUNCTION(BlueprintCallable, Category = Network)
+	void SetValue(const FRotator& InValue);
+	UFUNCTION(BlueprintPure, Category = Network)
+	FRotator GetValue() const;
+private:
+	TFGValueReplicatorCore<FRotator> Core;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "FGReplicatorBase.h"
+
+template<typename ValueType>
+struct TFGCrumb
+{
+	ValueType Value;
+	float Time = 0.0f;
+};
+
+template<typename ValueType>
+struct TFGCrumbWindow
+{
+	float GetAlpha(float Time) const
+	{
+		const float SegmentTime = P2->Time - P1->Time;
+		return SegmentTime > KINDA_SMALL_NUMBER ? (Time - P1->Time) / SegmentTime : 1.0f;
+	}
+	const TFGCrumb<ValueType>* P0 = nullptr;
+	const TFGCrumb<ValueType>* P1 = nullptr;
+	const TFGCrumb<ValueType>* P2 = nullptr;
+	const TFGCrumb<ValueType>* P3 = nullptr;
+};
+
+template<typename ValueType>
+struct TFGSmoothValueMathBase
+{
+	static ValueType Unwind(const ValueType& Value, const ValueType& Reference) { return Value; }
+	static ValueType Normalize(const ValueType& Value) { return Value; }
+	static ValueType Lerp(const ValueType& A, const ValueType& B, float Alpha) { return A + (B - A) * Alpha; }
+	static ValueType Extrapolate(const ValueType& Previous, const ValueType& Last, float Ratio) { return Last + (Last - Previous) * Ratio; }
+	// Tangents are scaled by crumb times so unevenly spaced crumbs do not overshoot.
+	static ValueType Cubic(const TFGCrumbWindow<ValueType>& Window, const ValueType& P0, const ValueType& P2, const ValueType& P3, float Alpha, float Tension)
+	{
+		const ValueType& P1 = Window.P1->Value;
+		const float SegmentTime = Window.P2->Time - Window.P1->Time;
+		const float Scale = 1.0f - Tension;
+		const ValueType M1 = (P2 - P0) * (Scale * SegmentTime / FMath::Max(Window.P2->Time - Window.P0->Time, KINDA_SMALL_NUMBER));
+		const ValueType M2 = (P3 - P1) * (Scale * SegmentTime / FMath::Max(Window.P3->Time - Window.P1->Time, KINDA_SMALL_NUMBER));
+		const float Alpha2 = Alpha * Alpha;
+		const float Alpha3 = Alpha2 * Alpha;
+		return P1 * (2.0f * Alpha3 - 3.0f * Alpha2 + 1.0f) + M1 * (Alpha3 - 2.0f * Alpha2 + Alpha) + P2 * (3.0f * Alpha2 - 2.0f * Alpha3) + M2 * (Alpha3 - Alpha2);
+	}
+};
+
+template<typename ValueType>
+struct TFGSmoothValueMath : public TFGSmoothValueMathBase<ValueType> {};
+
+template<>
+struct TFGSmoothValueMath<FRotator> : public TFGSmoothValueMathBase<FRotator>
+{
+	static FRotator Unwind(const FRotator& Value, const FRotator& Reference) { return Reference + (Value - Reference).GetNormalized(); }
+	static FRotator Normalize(const FRotator& Value) { return Value.GetNormalized(); }
+};
+
+template<>
+struct TFGSmoothValueMath<FQuat>
+{
+	static FQuat Unwind(const FQuat& Value, const FQuat& Reference) { return (Value | Reference) < 0.0f ? Value * -1.0f : Value; }
+	static FQuat Normalize(const FQuat& Value) { return Value.GetNormalized(); }
+	static FQuat Lerp(const FQuat& A, const FQuat& B, float Alpha) { return FQuat::Slerp(A, B, Alpha); }
+	static FQuat Extrapolate(const FQuat& Previous, const FQuat& Last, float Ratio)
+	{
+		FVector Axis;
+		float Angle;
+		(Last * Previous.Inverse()).ToAxisAndAngle(Axis, Angle);
+		return FQuat(Axis, Angle * Ratio) * Last;
+	}
+	static FQuat Cubic(const TFGCrumbWindow<FQuat>& Window, const FQuat& P0, const FQuat& P2, const FQuat& P3, float Alpha, float Tension)
+	{
+		const FQuat& P1 = Window.P1->Value;
+		FQuat Tangent1;
+		FQuat Tangent2;
+		FQuat::CalcTangents(P0, P1, P2, Tension, Tangent1);
+		FQuat::CalcTangents(P1, P2, P3, Tension, Tangent2);
+		return FQuat::Squad(P1, Tangent1, P2, Tangent2, Alpha);
+	}
+};
+
+template<typename ValueType, EFGSmoothReplicatorMode Mode>
+struct TFGSmoothReplicatorOperation;
+
+template<typename ValueType>
+struct TFGSmoothReplicatorOperation<ValueType, EFGSmoothReplicatorMode::ConstantVelocity>
+{
+	static const bool bExtrapolates = false;
+	static ValueType Sample(const TFGCrumbWindow<ValueType>& Window, float Time)
+	{
+		using FValueMath = TFGSmoothValueMath<ValueType>;
+		const ValueType& P1 = Window.P1->Value;
+		const float Alpha = FMath::Clamp(Window.GetAlpha(Time), 0.0f, 1.0f);
+		return FValueMath::Normalize(FValueMath::Lerp(P1, FValueMath::Unwind(Window.P2->Value, P1), Alpha));
+	}
+};
+
+template<typename ValueType, int32 TensionPercent>
+struct TFGSmoothReplicatorCubicOperation
+{
+	static const bool bExtrapolates = false;
+	static ValueType Sample(const TFGCrumbWindow<ValueType>& Window, float Time)
+	{
+		using FValueMath = TFGSmoothValueMath<ValueType>;
+		const ValueType& P1 = Window.P1->Value;
+		const ValueType P0 = FValueMath::Unwind(Window.P0->Value, P1);
+		const ValueType P2 = FValueMath::Unwind(Window.P2->Value, P1);
+		const ValueType P3 = FValueMath::Unwind(Window.P3->Value, P2);
+		const float Alpha = FMath::Clamp(Window.GetAlpha(Time), 0.0f, 1.0f);
+		return FValueMath::Normalize(FValueMath::Cubic(Window, P0, P2, P3, Alpha, static_cast<float>(TensionPercent) / 100.0f));
+	}
+};
+
+template<typename ValueType>
+struct TFGSmoothReplicatorOperation<ValueType, EFGSmoothReplicatorMode::CubicHermite> : public TFGSmoothReplicatorCubicOperation<ValueType, 50> {};
+
+template<typename ValueType>
+struct TFGSmoothReplicatorOperation<ValueType, EFGSmoothReplicatorMode::CatmullRom> : public TFGSmoothReplicatorCubicOperation<ValueType, 0> {};
+
+template<typename ValueType>
+struct TFGSmoothReplicatorOperation<ValueType, EFGSmoothReplicatorMode::DeadReckoning>
+{
+	static const bool bExtrapolates = true;
+	static ValueType Sample(const TFGCrumbWindow<ValueType>& Window, float Time)
+	{
+		using FValueMath = TFGSmoothValueMath<ValueType>;
+		const ValueType& P1 = Window.P1->Value;
+		const ValueType P2 = FValueMath::Unwind(Window.P2->Value, P1);
+		const float Alpha = FMath::Max(Window.GetAlpha(Time), 0.0f);
+		if (Alpha <= 1.0f)
+		{
+			return FValueMath::Normalize(FValueMath::Lerp(P1, P2, Alpha));
+		}
+		return FValueMath::Normalize(FValueMath::Extrapolate(P1, P2, Alpha - 1.0f));
+	}
+};
@@ -1,10 +1,9 @@
 #pragma once
 
 #include "FGReplicatorBase.h"
+#include "FGValueReplicatorCore.h"
 #include "FGValueReplicator.generated.h"
 
-DECLARE_DYNAMIC_MULTICAST_DELEGATE(FFGOnSmoothValueReplicationChanged);
-
 UCLASS()
 class NETWORKPROGRAMMING_API UFGValueReplicator : public UFGReplicatorBase
 {
@@ -12,44 +11,13 @@ class NETWORKPROGRAMMING_API UFGValueReplicator : public UFGReplicatorBase
 public:
 	virtual void Tick(float DeltaTime) override;
 	virtual void Init() override;
-	UFUNCTION(Server, Reliable)
-	void Server_SendTerminalValue(int32 SyncTag, float TerminalValue);
-	UFUNCTION(Server, Unreliable)
-	void Server_SendReplicatedValue(int32 SyncTag, float ReplicatedValue);
-	UFUNCTION(NetMulticast, Reliable)
-	void Multicast_SendTerminalValue(int32 SyncTag, float TerminalValue);
-	UFUNCTION(NetMulticast, Unreliable)
-	void Multicast_SendReplicatedValue(int32 SyncTag, float ReplicatedValue);
+	virtual EFGReplicatorSendType GatherSend(bool bIsDue) override;
+	virtual void WriteValue(FArchive& Ar) override;
+	virtual bool ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal) override;
 	UFUNCTION(BlueprintCallable, Category = Network)
 	void SetValue(float InValue);
 	UFUNCTION(BlueprintPure, Category = Network)
 	float GetValue() const;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = 1))
-	int32 NumberOfReplicationsPerSecond = 5;
-	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	EFGSmoothReplicatorMode SmoothMode = EFGSmoothReplicatorMode::ConstantVelocity;
-	UPROPERTY(BlueprintAssignable)
-	FFGOnSmoothValueReplicationChanged OnValueChanged;
-	bool ShouldTick() const;
 private:
-	void BroadcastDelegate();
-	struct FCrumb
-	{
-		float Value;
-	};
-	TArray<FCrumb, TInlineAllocator<10>> CrumbTrail;
-	float ReplicatedValueTarget = 0.0f;
-	float ReplicatedValueCurrent = 0.0f;
-	float ReplicatedValuePreviouslySent = 0.0f;
-	float StaticValueTimer = 0.0f;
-	float SleepAfterDuration = 1.0f;
-	int32 NextSynctag = 0;
-	int32 LastRecievedSyncTag = -1;
-	int32 LastRecievedCrumbSyncTag = -1;
-	float SyncTimer = 0.0f;
-	float LerpSpeed = 1.0f;
-	float CurrentCrumbTimeRemaining = 0.0f;
-	bool bHasRecievedTerminalValue = false;
-	bool bHasSentTerminalValue = false;
-	bool bIsSleeping = false;
-};
\ No newline at end of file
+	TFGValueReplicatorCore<float> Core;
+};
@@ -0,0 +1,313 @@
+#pragma once
+
+#include "FGReplicatorBase.h"
+#include "FGReplicatedValues.h"
+#include "FGReplicatorBatch.h"
+#include "FGSmoothReplicatorOperation.h"
+#include "../../FGRingBuffer.h"
+
+template<typename ValueType>
+class TFGValueReplicatorCore
+{
+public:
+	static const int32 MaxCrumbs = 16;
+
+	void Init()
+	{
+		SelectSmoothMode(EFGSmoothReplicatorMode::ConstantVelocity);
+		bIsSleeping = true;
+		bHasSentTerminalValue = true;
+		bHasRecievedTerminalValue = true;
+	}
+
+	void Tick(UFGReplicatorBase& Replicator, float DeltaTime)
+	{
+		const bool bIsLocallyControlled = Replicator.IsLocallyControlled();
+		if (bIsLocallyControlled)
+		{
+			TickSender(Replicator, DeltaTime);
+		}
+		else
+		{
+			if (Replicator.SmoothMode != SmoothMode)
+			{
+				SelectSmoothMode(Replicator.SmoothMode);
+			}
+			(this->*TickReceiverFunction)(Replicator, DeltaTime);
+			Replicator.SetJitterBufferStats(JitterBufferStats);
+		}
+		if (!ShouldTick(bIsLocallyControlled))
+		{
+			Replicator.SetShouldTick(false);
+			bIsSleeping = true;
+		}
+	}
+
+	bool SetValue(UFGReplicatorBase& Replicator, const ValueType& InValue)
+	{
+		if (InValue == ReplicatedValueCurrent || !Replicator.IsLocallyControlled())
+		{
+			return false;
+		}
+		ReplicatedValueCurrent = InValue;
+		if (bIsSleeping && HasMovedPastDeadband(Replicator))
+		{
+			Replicator.SetShouldTick(true);
+			bIsSleeping = false;
+			bHasSentTerminalValue = false;
+			StaticValueTimer = 0.0f;
+			// Nothing to predict from across a sleep, the first sends only look at how far the value moved.
+			ValueSentBeforePrevious = ReplicatedValuePreviouslySent;
+			TimeSinceLastSend = MAX_flt;
+		}
+		return true;
+	}
+
+	const ValueType& GetValue() const { return ReplicatedValueCurrent; }
+
+	EFGReplicatorSendType GatherSend(const UFGReplicatorBase& Replicator, bool bIsDue)
+	{
+		if (bIsSleeping || !bIsDue)
+		{
+			return EFGReplicatorSendType::None;
+		}
+		if (StaticValueTimer < SleepAfterDuration)
+		{
+			bHasSentTerminalValue = false;
+			if (!HasMovedPastDeadband(Replicator) || !IsAdaptiveSendDue(Replicator))
+			{
+				return EFGReplicatorSendType::None;
+			}
+			RecordSend();
+			return EFGReplicatorSendType::Value;
+		}
+		if (!bHasSentTerminalValue)
+		{
+			RecordSend();
+			bHasSentTerminalValue = true;
+			return EFGReplicatorSendType::Terminal;
+		}
+		return EFGReplicatorSendType::None;
+	}
+
+	void WriteValue(const UFGReplicatorBase& Replicator, FArchive& Ar)
+	{
+		ValueType Value = ReplicatedValueCurrent;
+		TFGReplicatedValueTraits<ValueType>::NetSerialize(Ar, Value, Replicator.GetQuantization());
+	}
+
+	bool ReceiveValue(UFGReplicatorBase& Replicator, FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal)
+	{
+		ValueType Value = TFGReplicatedValueTraits<ValueType>::GetDefault();
+		TFGReplicatedValueTraits<ValueType>::NetSerialize(Ar, Value, Replicator.GetQuantization());
+		if (Replicator.IsLocallyControlled())
+		{
+			return false;
+		}
+		// A tag older than the last one is a late batch, asleep or not, until the sender could have wrapped half the
+		// tag space since. The server checks tags too, it decides what gets relayed.
+		const double ArrivalTime = FPlatformTime::Seconds();
+		const double SyncTagWrapTime = static_cast<double>(1 << (Batch.GetSyncTagBits() - 1)) * Replicator.GetBatchSendInterval();
+		if (LastRecievedSyncTag != INDEX_NONE && ArrivalTime - LastArrivalTime < SyncTagWrapTime
+			&& !FFGReplicatorBatch::IsSyncTagNewer(Batch.SyncTag, static_cast<uint16>(LastRecievedSyncTag), Batch.GetSyncTagBits()))
+		{
+			return false;
+		}
+		const float MinCrumbInterval = 0.001f;
+		const float MaxCrumbInterval = 1.0f;
+		float SendInterval = Replicator.GetCrumbDuration();
+		if (CrumbTrail.IsEmpty())
+		{
+			PlaybackTime = 0.0f;
+			AddCrumb(ReplicatedValueCurrent, PlaybackTime);
+			bIsStarved = false;
+			CrumbInterval = SendInterval;
+		}
+		else
+		{
+			SendInterval = FMath::Clamp(FFGReplicatorBatch::GetTimestampDelta(Batch.Timestamp, LastRecievedTimestamp), MinCrumbInterval, MaxCrumbInterval);
+			CrumbInterval += (SendInterval - CrumbInterval) * 0.25f;
+			// RFC 3550 style estimate, arrivals after the sender went to sleep say nothing about the link.
+			if (!bHasRecievedTerminalValue)
+			{
+				const float Deviation = FMath::Min(FMath::Abs(static_cast<float>(ArrivalTime - LastArrivalTime) - SendInterval), MaxCrumbInterval);
+				JitterBufferStats.Jitter += (Deviation - JitterBufferStats.Jitter) / 16.0f;
+			}
+		}
+		LastArrivalTime = ArrivalTime;
+		LastRecievedTimestamp = Batch.Timestamp;
+		LastRecievedSyncTag = Batch.SyncTag;
+		bHasRecievedTerminalValue = bIsTerminal;
+		if (CrumbTrail.IsFull())
+		{
+			CrumbTrail.PopFront();
+			JitterBufferStats.Overruns++;
+		}
+		AddCrumb(Value, CrumbTrail.Last().Time + SendInterval);
+		Replicator.SetShouldTick(true);
+		return true;
+	}
+
+private:
+	void TickSender(const UFGReplicatorBase& Replicator, float DeltaTime)
+	{
+		if (HasMovedPastDeadband(Replicator))
+		{
+			StaticValueTimer = 0.0f;
+		}
+		else
+		{
+			StaticValueTimer += DeltaTime;
+		}
+		TimeSinceLastSend += DeltaTime;
+	}
+
+	bool IsAdaptiveSendDue(const UFGReplicatorBase& Replicator) const
+	{
+		if (!Replicator.bAdaptiveReplicationRate)
+		{
+			return true;
+		}
+		const float MinInterval = 1.0f / static_cast<float>(FMath::Max(Replicator.NumberOfReplicationsPerSecond, 1));
+		const float MaxInterval = 1.0f / static_cast<float>(FMath::Max(Replicator.MinNumberOfReplicationsPerSecond, 1));
+		if (TimeSinceLastSend >= MaxInterval)
+		{
+			return true;
+		}
+		using FValueMath = TFGSmoothValueMath<ValueType>;
+		const float Ratio = TimeSinceLastSend / FMath::Max(PreviousSendInterval, KINDA_SMALL_NUMBER);
+		const ValueType Predicted = FValueMath::Extrapolate(FValueMath::Unwind(ValueSentBeforePrevious, ReplicatedValuePreviouslySent), ReplicatedValuePreviouslySent, Ratio);
+		const float PredictionError = TFGReplicatedValueTraits<ValueType>::GetDistance(ReplicatedValueCurrent, Predicted);
+		const float Urgency = FMath::Clamp((TimeSinceLastSend - MinInterval) / FMath::Max(MaxInterval - MinInterval, KINDA_SMALL_NUMBER), 0.0f, 1.0f);
+		return PredictionError >= Replicator.AdaptiveErrorTolerance * (1.0f - Urgency);
+	}
+
+	void RecordSend()
+	{
+		ValueSentBeforePrevious = ReplicatedValuePreviouslySent;
+		ReplicatedValuePreviouslySent = ReplicatedValueCurrent;
+		PreviousSendInterval = TimeSinceLastSend;
+		TimeSinceLastSend = 0.0f;
+	}
+
+	template<EFGSmoothReplicatorMode Mode>
+	void TickReceiver(UFGReplicatorBase& Replicator, float DeltaTime)
+	{
+		using FOperation = TFGSmoothReplicatorOperation<ValueType, Mode>;
+		if (CrumbTrail.IsEmpty())
+		{
+			return;
+		}
+		const float CrumbDuration = CrumbInterval;
+		const float TrailEnd = CrumbTrail.Last().Time;
+		const float DepthSmoothing = FMath::Min(DeltaTime / (CrumbDuration * 2.0f), 1.0f);
+		JitterBufferStats.BufferDepth += (TrailEnd - PlaybackTime - JitterBufferStats.BufferDepth) * DepthSmoothing;
+		JitterBufferStats.TargetDepth = FMath::Min(CrumbDuration * 0.5f + DeltaTime + JitterBufferStats.Jitter * Replicator.JitterBufferScale, CrumbDuration * (MaxCrumbs - 2));
+		float PlaybackRate = 1.0f;
+		if (!bHasRecievedTerminalValue)
+		{
+			const float DepthError = (JitterBufferStats.BufferDepth - JitterBufferStats.TargetDepth) / FMath::Max(JitterBufferStats.TargetDepth, KINDA_SMALL_NUMBER);
+			PlaybackRate += FMath::Clamp(DepthError, -Replicator.MaxTimeStretch, Replicator.MaxTimeStretch);
+		}
+		JitterBufferStats.PlaybackRate = PlaybackRate;
+		const float MaxPlaybackTime = FOperation::bExtrapolates && !bHasRecievedTerminalValue ? TrailEnd + CrumbDuration : TrailEnd;
+		PlaybackTime = FMath::Clamp(PlaybackTime + PlaybackRate * DeltaTime, CrumbTrail.First().Time, MaxPlaybackTime);
+		const bool bIsAtEnd = PlaybackTime >= MaxPlaybackTime;
+		if (bIsAtEnd && !bHasRecievedTerminalValue && !bIsStarved)
+		{
+			JitterBufferStats.Underruns++;
+		}
+		bIsStarved = bIsAtEnd;
+		// Keep one crumb before the segment being played, the cubic modes need it.
+		while (CrumbTrail.Num() >= 3 && CrumbTrail[2].Time <= PlaybackTime)
+		{
+			CrumbTrail.PopFront();
+		}
+		ReplicatedValueCurrent = FOperation::Sample(GetCrumbWindow(), PlaybackTime);
+		if (bHasRecievedTerminalValue && PlaybackTime >= TrailEnd)
+		{
+			ReplicatedValueCurrent = CrumbTrail.Last().Value;
+			CrumbTrail.Reset();
+		}
+	}
+
+	void SelectSmoothMode(EFGSmoothReplicatorMode Mode)
+	{
+		SmoothMode = Mode;
+		switch (Mode)
+		{
+		case EFGSmoothReplicatorMode::CubicHermite:
+			TickReceiverFunction = &TFGValueReplicatorCore::TickReceiver<EFGSmoothReplicatorMode::CubicHermite>;
+			break;
+		case EFGSmoothReplicatorMode::CatmullRom:
+			TickReceiverFunction = &TFGValueReplicatorCore::TickReceiver<EFGSmoothReplicatorMode::CatmullRom>;
+			break;
+		case EFGSmoothReplicatorMode::DeadReckoning:
+			TickReceiverFunction = &TFGValueReplicatorCore::TickReceiver<EFGSmoothReplicatorMode::DeadReckoning>;
+			break;
+		default:
+			TickReceiverFunction = &TFGValueReplicatorCore::TickReceiver<EFGSmoothReplicatorMode::ConstantVelocity>;
+			break;
+		}
+	}
+
+	void AddCrumb(const ValueType& Value, float Time)
+	{
+		FCrumb& Crumb = CrumbTrail.Add(FCrumb());
+		Crumb.Value = Value;
+		Crumb.Time = Time;
+	}
+
+	TFGCrumbWindow<ValueType> GetCrumbWindow() const
+	{
+		const int32 LastIndex = CrumbTrail.Num() - 1;
+		const int32 SegmentStart = CrumbTrail.Num() >= 3 && CrumbTrail[1].Time <= PlaybackTime ? 1 : 0;
+		TFGCrumbWindow<ValueType> Window;
+		Window.P0 = &CrumbTrail[FMath::Max(SegmentStart - 1, 0)];
+		Window.P1 = &CrumbTrail[SegmentStart];
+		Window.P2 = &CrumbTrail[FMath::Min(SegmentStart + 1, LastIndex)];
+		Window.P3 = &CrumbTrail[FMath::Min(SegmentStart + 2, LastIndex)];
+		return Window;
+	}
+
+	bool HasMovedPastDeadband(const UFGReplicatorBase& Replicator) const
+	{
+		if (Replicator.Deadband <= 0.0f)
+		{
+			return ReplicatedValueCurrent != ReplicatedValuePreviouslySent;
+		}
+		return TFGReplicatedValueTraits<ValueType>::GetDistance(ReplicatedValueCurrent, ReplicatedValuePreviouslySent) > Replicator.Deadband;
+	}
+
+	bool ShouldTick(bool bIsLocallyControlled) const
+	{
+		if (bIsLocallyControlled)
+		{
+			return !bHasSentTerminalValue;
+		}
+		return !(bHasRecievedTerminalValue && CrumbTrail.IsEmpty());
+	}
+
+	using FCrumb = TFGCrumb<ValueType>;
+	using FTickReceiverFunction = void (TFGValueReplicatorCore::*)(UFGReplicatorBase&, float);
+	TFGRingBuffer<FCrumb, MaxCrumbs> CrumbTrail;
+	FTickReceiverFunction TickReceiverFunction = nullptr;
+	EFGSmoothReplicatorMode SmoothMode = EFGSmoothReplicatorMode::ConstantVelocity;
+	float PlaybackTime = 0.0f;
+	double LastArrivalTime = 0.0;
+	uint16 LastRecievedTimestamp = 0;
+	float CrumbInterval = 0.1f;
+	ValueType ValueSentBeforePrevious = TFGReplicatedValueTraits<ValueType>::GetDefault();
+	float TimeSinceLastSend = MAX_flt;
+	float PreviousSendInterval = MAX_flt;
+	FFGJitterBufferStats JitterBufferStats;
+	ValueType ReplicatedValueCurrent = TFGReplicatedValueTraits<ValueType>::GetDefault();
+	ValueType ReplicatedValuePreviouslySent = TFGReplicatedValueTraits<ValueType>::GetDefault();
+	float StaticValueTimer = 0.0f;
+	float SleepAfterDuration = 1.0f;
+	int32 LastRecievedSyncTag = INDEX_NONE;
+	bool bHasRecievedTerminalValue = false;
+	bool bHasSentTerminalValue = false;
+	bool bIsSleeping = false;
+	bool bIsStarved = false;
+};
@@ -0,0 +1,39 @@
+#include "FGVector2DReplicator.h"
+
+void UFGVector2DReplicator::Tick(float DeltaTime)
+{
+	Core.Tick(*this, DeltaTime);
+}
+
+void UFGVector2DReplicator::Init()
+{
+	Core.Init();
+}
+
+EFGReplicatorSendType UFGVector2DReplicator::GatherSend(bool bIsDue)
+{
+	return Core.GatherSend(*this, bIsDue);
+}
+
+void UFGVector2DReplicator::WriteValue(FArchive& Ar)
+{
+	Core.WriteValue(*this, Ar);
+}
+
+bool UFGVector2DReplicator::ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal)
+{
+	return Core.ReceiveValue(*this, Ar, Batch, bIsTerminal);
+}
+
+void UFGVector2DReplicator::SetValue(const FVector2D& InValue)
+{
+	if (Core.SetValue(*this, InValue))
+	{
+		BroadcastDelegate();
+	}
+}
+
+FVector2D UFGVector2DReplicator::GetValue() const
+{
+	return Core.GetValue();
+}
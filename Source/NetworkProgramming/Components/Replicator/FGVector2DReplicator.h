@@ -0,0 +1,23 @@
+#pragma once
+
+#include "FGReplicatorBase.h"
+#include "FGValueReplicatorCore.h"
+#include "FGVector2DReplicator.generated.h"
+
+UCLASS()
+class NETWORKPROGRAMMING_API UFGVector2DReplicator : public UFGReplicatorBase
+{
+	GENERATED_BODY()
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual void Init() override;
+	virtual EFGReplicatorSendType GatherSend(bool bIsDue) override;
+	virtual void WriteValue(FArchive& Ar) override;
+	virtual bool ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal) override;
+	UFUNCTION(BlueprintCallable, Category = Network)
+	void SetValue(const FVector2D& InValue);
+	UFUNCTION(BlueprintPure, Category = Network)
+	FVector2D GetValue() const;
+private:
+	TFGValueReplicatorCore<FVector2D> Core;
+};
@@ -0,0 +1,39 @@
+#include "FGVectorReplicator.h"
+
+void UFGVectorReplicator::Tick(float DeltaTime)
+{
+	Core.Tick(*this, DeltaTime);
+}
+
+void UFGVectorReplicator::Init()
+{
+	Core.Init();
+}
+
+EFGReplicatorSendType UFGVectorReplicator::GatherSend(bool bIsDue)
+{
+	return Core.GatherSend(*this, bIsDue);
+}
+
+void UFGVectorReplicator::WriteValue(FArchive& Ar)
+{
+	Core.WriteValue(*this, Ar);
+}
+
+bool UFGVectorReplicator::ReceiveValue(FArchive& Ar, const FFGReplicatorBatch& Batch, bool bIsTerminal)
+{
+	return Core.ReceiveValue(*this, Ar, Batch, bIsTerminal);
+}
+
+void UFGVectorReplicator::SetValue(const FVector& InValue)
+{
+	if (Core.SetValue(*this, InValue))
+	{
+		BroadcastDelegate();
+	}
+}
+
+FVector UFGVectorReplicator::GetValue() const
+{
+	return Core.GetValue();
+}
@@ -4,6 +4,7 @@
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
 #include "Misc/DefaultValueHelper.h"
+#include "../../Player/FGPlayer.h"
 
 void UFGNetDebugWidget::UpdateNetworkSimulationSettings(const FFGBlueprintNetworkSimulationSettings& InPackets)
 {
@@ -33,9 +34,9 @@ void UFGNetDebugWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
 	Super::NativeTick(MyGeometry, InDeltaTime);
 	if (APlayerController* PC = GetOwningPlayer())
 	{
-		if (APlayerState* PlayerState = PC->GetPlayerState<APlayerState>())
+		if (AFGPlayer* Player = Cast<AFGPlayer>(PC->GetPawn()))
 		{
-			BP_UpdatePing(static_cast<int32>(PlayerState->GetPing()));
+			BP_UpdatePing(Player->GetPing());
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "FGGameState.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "FGPickup.h"
+#include "Subsystems/FGClockSyncSubsystem.h"
+
+AFGGameState::AFGGameState()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = true;
+}
+
+void AFGGameState::BeginPlay()
+{
+	Super::BeginPlay();
+	BuildPickupRegistry();
+}
+
+void AFGGameState::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (!IsClockSynced())
+	{
+		return;
+	}
+	DueRespawns.Reset();
+	RespawnWheel.Advance(GetCurrentTick(), DueRespawns);
+	for (const uint16 PickupIndex : DueRespawns)
+	{
+		// Entries of an earlier respawn can still be on the wheel after the state replicated a newer one.
+		AFGPickup* Pickup = Pickups.IsValidIndex(PickupIndex) ? Pickups[PickupIndex] : nullptr;
+		if (Pickup == nullptr || PickupStates.IsAvailable(PickupIndex) || static_cast<int16>(PickupStates.RespawnTicks[PickupIndex] - GetCurrentTick()) > 0)
+		{
+			continue;
+		}
+		if (HasAuthority())
+		{
+			PickupStates.SetAvailable(PickupIndex, true);
+		}
+		Pickup->SetAvailable(true);
+	}
+}
+
+void AFGGameState::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(AFGGameState, PickupStates);
+}
+
+bool AFGGameState::ConsumePickup(AFGPickup* Pickup)
+{
+	if (!HasAuthority() || Pickup == nullptr || !Pickups.IsValidIndex(Pickup->PickupIndex))
+	{
+		return false;
+	}
+	const int32 PickupIndex = Pickup->PickupIndex;
+	if (!PickupStates.IsAvailable(PickupIndex))
+	{
+		return false;
+	}
+	const int32 RespawnTicks = FMath::Max(FMath::CeilToInt(Pickup->ReActivateTime * 1000.0f / FFGPickupStates::TickMs), 1);
+	PickupStates.SetAvailable(PickupIndex, false);
+	PickupStates.RespawnTicks[PickupIndex] = static_cast<uint16>(GetCurrentTick() + RespawnTicks);
+	SchedulePickupRespawn(PickupIndex);
+	Pickup->SetAvailable(false);
+	return true;
+}
+
+bool AFGGameState::IsPickupAvailable(const AFGPickup* Pickup) const
+{
+	return Pickup != nullptr && Pickups.IsValidIndex(Pickup->PickupIndex) && PickupStates.IsAvailable(Pickup->PickupIndex);
+}
+
+void AFGGameState::BuildPickupRegistry()
+{
+	if (bPickupRegistryBuilt)
+	{
+		return;
+	}
+	bPickupRegistryBuilt = true;
+	for (TActorIterator<AFGPickup> It(GetWorld()); It; ++It)
+	{
+		if (It->IsNetStartupActor())
+		{
+			Pickups.Add(*It);
+		}
+	}
+	Pickups.Sort([](const AFGPickup& A, const AFGPickup& B) { return A.GetPathName() < B.GetPathName(); });
+	if (!ensure(Pickups.Num() <= FFGPickupStates::MaxPickups))
+	{
+		Pickups.SetNum(FFGPickupStates::MaxPickups);
+	}
+	for (int32 Index = 0; Index < Pickups.Num(); ++Index)
+	{
+		Pickups[Index]->PickupIndex = Index;
+	}
+	if (HasAuthority())
+	{
+		PickupStates.Init(Pickups.Num());
+		for (int32 Index = 0; Index < Pickups.Num(); ++Index)
+		{
+			PickupStates.SetAvailable(Index, true);
+		}
+	}
+}
+
+uint16 AFGGameState::GetCurrentTick() const
+{
+	const UFGClockSyncSubsystem* ClockSync = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+	return ClockSync != nullptr ? FFGPickupStates::ServerTimeMsToTick(ClockSync->GetServerTimeMs()) : 0;
+}
+
+bool AFGGameState::IsClockSynced() const
+{
+	const UFGClockSyncSubsystem* ClockSync = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+	return ClockSync != nullptr && (HasAuthority() || ClockSync->GetLocalStats().NumberSamples > 0);
+}
+
+void AFGGameState::SchedulePickupRespawn(int32 PickupIndex)
+{
+	RespawnWheel.Schedule(static_cast<uint16>(PickupIndex), PickupStates.RespawnTicks[PickupIndex]);
+}
+
+void AFGGameState::OnRep_PickupStates()
+{
+	BuildPickupRegistry();
+	const int32 NumberPickups = FMath::Min(Pickups.Num(), PickupStates.Num());
+	ensureMsgf(Pickups.Num() == PickupStates.Num(), TEXT("Client has %d pickups, the server %d."), Pickups.Num(), PickupStates.Num());
+	for (int32 Index = 0; Index < NumberPickups; ++Index)
+	{
+		AFGPickup* Pickup = Pickups[Index];
+		if (Pickup == nullptr)
+		{
+			continue;
+		}
+		const bool bAvailable = PickupStates.IsAvailable(Index);
+		if (Pickup->IsAvailable() != bAvailable)
+		{
+			Pickup->SetAvailable(bAvailable);
+		}
+		// Everything else taken is already on the wheel from an earlier replication.
+		const bool bKnown = Index < LastPickupStates.Num();
+		if (!bAvailable && (!bKnown || LastPickupStates.IsAvailable(Index) || LastPickupStates.RespawnTicks[Index] != PickupStates.RespawnTicks[Index]))
+		{
+			SchedulePickupRespawn(Index);
+		}
+	}
+	LastPickupStates = PickupStates;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "FGPickupStates.h"
+#include "FGTimingWheel.h"
+#include "FGGameState.generated.h"
+
+class AFGPickup;
+
+UCLASS()
+class NETWORKPROGRAMMING_API AFGGameState : public AGameStateBase
+{
+	GENERATED_BODY()
+public:
+	AFGGameState();
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaSeconds) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	bool ConsumePickup(AFGPickup* Pickup);
+	bool IsPickupAvailable(const AFGPickup* Pickup) const;
+private:
+	void BuildPickupRegistry();
+	uint16 GetCurrentTick() const;
+	bool IsClockSynced() const;
+	void SchedulePickupRespawn(int32 PickupIndex);
+	UFUNCTION()
+	void OnRep_PickupStates();
+	UPROPERTY(Transient)
+	TArray<AFGPickup*> Pickups;
+	UPROPERTY(ReplicatedUsing = OnRep_PickupStates)
+	FFGPickupStates PickupStates;
+	FFGPickupStates LastPickupStates;
+	FFGTimingWheel RespawnWheel;
+	TArray<uint16> DueRespawns;
+	bool bPickupRegistryBuilt = false;
+};
@@ -4,20 +4,23 @@
 #include "Components/SphereComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
-#include "TimerManager.h"
+#include "Subsystems/FGPickupAnimationSubsystem.h"
+#include "Subsystems/FGPickupGridSubsystem.h"
 
 AFGPickup::AFGPickup()
 {
-	PrimaryActorTick.bStartWithTickEnabled = true;
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
 	SphereComponent->SetupAttachment(RootComponent);
+	SphereComponent->SetGenerateOverlapEvents(false);
+	SphereComponent->SetCollisionProfileName(TEXT("NoCollision"));
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	MeshComponent->SetupAttachment(RootComponent);
 	MeshComponent->SetGenerateOverlapEvents(false);
 	MeshComponent->SetCollisionProfileName(TEXT("NoCollision"));
 	SetReplicates(true);
+	NetDormancy = DORM_Initial;
 }
 
 AFGPickup::~AFGPickup()
@@ -27,8 +30,20 @@ AFGPickup::~AFGPickup()
 void AFGPickup::BeginPlay()
 {
 	Super::BeginPlay();
-	SphereComponent->OnComponentBeginOverlap.AddDynamic(this, &AFGPickup::OverlapBegin);
-	CachedMeshRelativeLocation = MeshComponent->GetRelativeLocation();
+	if (UFGPickupGridSubsystem* PickupGrid = GetWorld()->GetSubsystem<UFGPickupGridSubsystem>())
+	{
+		PickupGrid->RegisterPickup(this, GetRadius());
+	}
+	if (UFGPickupAnimationSubsystem* AnimationSubsystem = GetWorld()->GetSubsystem<UFGPickupAnimationSubsystem>())
+	{
+		bAnimatedByManager = AnimationSubsystem->RegisterPickup(this);
+	}
+	if (bAnimatedByManager)
+	{
+		MeshComponent->SetVisibility(false);
+		// The game state may have hidden us before we were handed to the manager.
+		SetVisibility(!bPickedUp);
+	}
 }
 
 void AFGPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -36,50 +51,37 @@ void AFGPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 	if (const UWorld* World = GetWorld())
 	{
-		World->GetTimerManager().ClearTimer(ReActivateHandle);
+		if (UFGPickupAnimationSubsystem* AnimationSubsystem = World->GetSubsystem<UFGPickupAnimationSubsystem>())
+		{
+			AnimationSubsystem->UnregisterPickup(this);
+		}
+		if (UFGPickupGridSubsystem* PickupGrid = World->GetSubsystem<UFGPickupGridSubsystem>())
+		{
+			PickupGrid->UnregisterPickup(this);
+		}
 	}
 }
 
-void AFGPickup::Tick(float DeltaTime)
+float AFGPickup::GetRadius() const
 {
-	Super::Tick(DeltaTime);
-	const float PulsatingValue = FMath::MakePulsatingValue(GetWorld()->GetTimeSeconds(), 0.65f) * 30.0f;
-	const FVector NewLocation = CachedMeshRelativeLocation + FVector(0.0f, 0.0f, PulsatingValue);
-	FHitResult Hit;
-	MeshComponent->SetRelativeLocation(NewLocation, false, &Hit, ETeleportType::TeleportPhysics);
-	MeshComponent->AddRelativeRotation(FRotator(0.0f, 20.0f * DeltaTime, 0.0f), false, &Hit, ETeleportType::TeleportPhysics);
+	return SphereComponent->GetScaledSphereRadius();
 }
 
-void AFGPickup::ReActivatePickup()
+void AFGPickup::SetAvailable(bool bAvailable)
 {
-	bPickedUp = false;
-	RootComponent->SetVisibility(true, true);
-	SphereComponent->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
-	SetActorTickEnabled(true);
+	bPickedUp = !bAvailable;
+	SetVisibility(bAvailable);
 }
 
-void AFGPickup::OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AFGPickup::SetVisibility(bool bVisible)
 {
-	if (bPickedUp)
+	if (!bAnimatedByManager)
 	{
+		RootComponent->SetVisibility(bVisible, true);
 		return;
 	}
-	if (AFGPlayer* Player = Cast<AFGPlayer>(OtherActor))
+	if (UFGPickupAnimationSubsystem* AnimationSubsystem = GetWorld()->GetSubsystem<UFGPickupAnimationSubsystem>())
 	{
-		Player->OnPickup(this);
+		AnimationSubsystem->SetPickupVisible(this, bVisible);
 	}
-}
-
-void AFGPickup::RestartPickup()
-{
-	bPickedUp = true;
-	SphereComponent->SetCollisionProfileName(TEXT("NoCollision"));
-	SetVisibility(false);
-	GetWorldTimerManager().SetTimer(ReActivateHandle, this, &AFGPickup::ReActivatePickup, ReActivateTime, false);
-	SetActorTickEnabled(false);
-}
-
-void AFGPickup::SetVisibility(bool bVisible)
-{
-	RootComponent->SetVisibility(bVisible, true);
 }
\ No newline at end of file
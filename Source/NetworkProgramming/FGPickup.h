@@ -22,9 +22,10 @@ public:
 	~AFGPickup();
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
-	virtual void Tick(float DeltaTime) override;
 	void SetVisibility(bool bVisible);
-	void RestartPickup();
+	void SetAvailable(bool bAvailable);
+	bool IsAvailable() const { return !bPickedUp; }
+	float GetRadius() const;
 	UPROPERTY(VisibleDefaultsOnly, Category = Collision)
 	USphereComponent* SphereComponent;
 	UPROPERTY(VisibleDefaultsOnly, Category = Mesh)
@@ -38,11 +39,8 @@ public:
 	UPROPERTY(EditAnywhere)
 	float ReActivateTime = 5.0f;
 private:
-	FVector CachedMeshRelativeLocation = FVector::ZeroVector;
-	FTimerHandle ReActivateHandle;
-	UFUNCTION()
-	void ReActivatePickup();
-	UFUNCTION()
-	void OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	friend class AFGGameState;
 	bool bPickedUp = false;
+	bool bAnimatedByManager = false;
+	int32 PickupIndex = INDEX_NONE;
 };
@@ -0,0 +1,55 @@
+#include "FGPickupStates.h"
+#include "Engine/NetSerialization.h"
+
+bool FFGPickupStates::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	uint32 NumberPickups = static_cast<uint32>(Num());
+	Ar.SerializeIntPacked(NumberPickups);
+	if (Ar.IsLoading())
+	{
+		if (NumberPickups > static_cast<uint32>(MaxPickups))
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+		Init(static_cast<int32>(NumberPickups));
+	}
+	for (int32 WordIndex = 0; WordIndex < AvailableBits.Num(); ++WordIndex)
+	{
+		const int32 NumberBits = FMath::Min(static_cast<int32>(NumberPickups) - WordIndex * 32, 32);
+		Ar.SerializeBits(&AvailableBits[WordIndex], NumberBits);
+		if (NumberBits < 32)
+		{
+			AvailableBits[WordIndex] &= (1u << NumberBits) - 1;
+		}
+	}
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		if (!IsAvailable(Index))
+		{
+			Ar << RespawnTicks[Index];
+		}
+	}
+	return true;
+}
+
+void FFGPickupStates::Init(int32 InNumberPickups)
+{
+	AvailableBits.Init(0, FMath::DivideAndRoundUp(InNumberPickups, 32));
+	RespawnTicks.Init(0, InNumberPickups);
+}
+
+void FFGPickupStates::SetAvailable(int32 Index, bool bAvailable)
+{
+	const uint32 Mask = 1u << (Index % 32);
+	if (bAvailable)
+	{
+		AvailableBits[Index / 32] |= Mask;
+	}
+	else
+	{
+		AvailableBits[Index / 32] &= ~Mask;
+	}
+}
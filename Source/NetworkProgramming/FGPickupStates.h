@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGPickupStates.generated.h"
+
+// Ticks count TickMs steps of the synced server clock and wrap at 16 bits.
+USTRUCT()
+struct FFGPickupStates
+{
+	GENERATED_BODY()
+public:
+	static const int32 TickMs = 100;
+	static const int32 MaxPickups = MAX_uint16;
+	static uint16 ServerTimeMsToTick(int32 ServerTimeMs) { return static_cast<uint16>(ServerTimeMs / TickMs); }
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	void Init(int32 InNumberPickups);
+	int32 Num() const { return RespawnTicks.Num(); }
+	bool IsAvailable(int32 Index) const { return (AvailableBits[Index / 32] & (1u << (Index % 32))) != 0; }
+	void SetAvailable(int32 Index, bool bAvailable);
+	UPROPERTY()
+	TArray<uint32> AvailableBits;
+	UPROPERTY()
+	TArray<uint16> RespawnTicks;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGPickupStates> : public TStructOpsTypeTraitsBase2<FFGPickupStates>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Fixed capacity FIFO, pushing to a full buffer overwrites the oldest element.
+template<typename ElementType, int32 Capacity>
+class TFGRingBuffer
+{
+	static_assert(Capacity > 0, "TFGRingBuffer needs a positive capacity.");
+public:
+	int32 Num() const { return Count; }
+	int32 Max() const { return Capacity; }
+	bool IsEmpty() const { return Count == 0; }
+	bool IsFull() const { return Count == Capacity; }
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+	}
+	ElementType& Add(const ElementType& Element)
+	{
+		if (IsFull())
+		{
+			PopFront();
+		}
+		ElementType& Slot = Elements[(Head + Count) % Capacity];
+		Slot = Element;
+		Count++;
+		return Slot;
+	}
+	void PopFront(int32 NumToPop = 1)
+	{
+		NumToPop = FMath::Min(NumToPop, Count);
+		Head = (Head + NumToPop) % Capacity;
+		Count -= NumToPop;
+	}
+	ElementType& operator[](int32 Index)
+	{
+		check(Index >= 0 && Index < Count);
+		return Elements[(Head + Index) % Capacity];
+	}
+	const ElementType& operator[](int32 Index) const
+	{
+		check(Index >= 0 && Index < Count);
+		return Elements[(Head + Index) % Capacity];
+	}
+	ElementType& First() { return (*this)[0]; }
+	const ElementType& First() const { return (*this)[0]; }
+	ElementType& Last() { return (*this)[Count - 1]; }
+	const ElementType& Last() const { return (*this)[Count - 1]; }
+private:
+	ElementType Elements[Capacity];
+	int32 Head = 0;
+	int32 Count = 0;
+};
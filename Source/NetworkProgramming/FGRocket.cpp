@@ -1,99 +1,176 @@
 #include "FGRocket.h"
-#include "DrawDebugHelpers.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
-#include "Kismet/GameplayStatics.h"
+#include "Net/UnrealNetwork.h"
 #include "Player/FGPlayer.h"
+#include "Subsystems/FGEffectPoolSubsystem.h"
+#include "Subsystems/FGLagCompensationSubsystem.h"
+#include "Subsystems/FGProjectileSubsystem.h"
+#include "Subsystems/FGRocketPoolSubsystem.h"
 
 AFGRocket::AFGRocket()
 {
-	PrimaryActorTick.bStartWithTickEnabled = false;
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	MeshComponent->SetupAttachment(RootComponent);
 	MeshComponent->SetGenerateOverlapEvents(false);
 	MeshComponent->SetCollisionProfileName(TEXT("NoCollision"));
 	SetReplicates(true);
+	bAlwaysRelevant = true;
+	NetDormancy = DORM_DormantAll;
 }
 
 void AFGRocket::BeginPlay()
 {
 	Super::BeginPlay();
 	CachedCollisionQueryParams.AddIgnoredActor(this);
-	// Owner will be the player that instantiated this.
-	CachedCollisionQueryParams.AddIgnoredActor(GetOwner());
 	SetRocketVisibility(false);
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+	{
+		RocketPool->RegisterRocket(this);
+	}
+	if (UFGEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UFGEffectPoolSubsystem>())
+	{
+		EffectPool->PrewarmEffect(Explosion);
+	}
 }
 
-void AFGRocket::Tick(float DeltaTime)
+void AFGRocket::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
-	LifeTimeElapsed -= DeltaTime;
-	DistanceMoved += MovementVelocity * DeltaTime;
-	FacingRotationStart = FQuat::Slerp(FacingRotationStart.ToOrientationQuat(), FacingRotationCorrection, 0.9f * DeltaTime).Vector();
-#if !UE_BUILD_SHIPPING
-	if (bDebugDrawCorrection)
-	{
-		const float ArrowLength = 3000.0f;
-		const float ArrowSize = 50.0f;
-		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + OrigianlFacingDirection * ArrowLength, ArrowSize, FColor::Red);
-		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + FacingRotationStart * ArrowLength, ArrowSize, FColor::Green);
-	}
-#endif // !UE_BUILD_SHIPPING
-	const FVector NewLocation = RocketStartLocation + FacingRotationStart * DistanceMoved;
-	SetActorLocation(NewLocation);
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+	{
+		RocketPool->UnregisterRocket(this);
+	}
+	if (UFGProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UFGProjectileSubsystem>())
+	{
+		ProjectileSubsystem->RemoveProjectile(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+bool AFGRocket::TraceFlight(const FVector& Start, const FVector& End, AFGPlayer*& OutHitPlayer) const
+{
+	if (TraceRewound(Start, End, OutHitPlayer))
+	{
+		return true;
+	}
 	FHitResult Hit;
-	const FVector StartLocation = NewLocation;
-	const FVector EndLocation = StartLocation + FacingRotationStart * 100.0f;
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLocation, EndLocation, ECC_Visibility, CachedCollisionQueryParams);
-	if (Hit.bBlockingHit)
+	GetWorld()->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, CachedCollisionQueryParams);
+	return ShouldExplodeOnHit(Hit, OutHitPlayer);
+}
+
+bool AFGRocket::TraceRewound(const FVector& Start, const FVector& End, AFGPlayer*& OutHitPlayer) const
+{
+	OutHitPlayer = nullptr;
+	// The server decides player hits against where the shooter saw them, the current positions are only used for effects.
+	UFGLagCompensationSubsystem* LagCompensationSubsystem = HasAuthority() ? GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>() : nullptr;
+	if (LagCompensationSubsystem == nullptr)
+	{
+		return false;
+	}
+	FVector RewoundHitLocation = FVector::ZeroVector;
+	const double ViewTime = LagCompensationSubsystem->GetViewTime(GetShooter());
+	return LagCompensationSubsystem->RewindTrace(Start, End, ViewTime, GetShooter(), OutHitPlayer, RewoundHitLocation);
+}
+
+bool AFGRocket::ShouldExplodeOnHit(const FHitResult& Hit, AFGPlayer*& OutHitPlayer) const
+{
+	OutHitPlayer = nullptr;
+	if (!Hit.bBlockingHit)
+	{
+		return false;
+	}
+	AFGPlayer* Player = Cast<AFGPlayer>(Hit.Actor);
+	if (Player == nullptr || !HasAuthority() || GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>() == nullptr)
 	{
-		if (AFGPlayer* Player = Cast<AFGPlayer>(Hit.Actor))
+		OutHitPlayer = Player;
+		return true;
+	}
+	return false;
+}
+
+void AFGRocket::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME_CONDITION(AFGRocket, PoolIndex, COND_InitialOnly);
+}
+
+void AFGRocket::StartMoving(const FVector& Forward, const FVector& InStartLocation, AFGPlayer* InShooter, float ElapsedTime)
+{
+	if (bIsFree)
+	{
+		if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
 		{
-			Player->OnHit(this);
+			RocketPool->ClaimRocket(this);
 		}
-		Explode();
 	}
-	if (LifeTimeElapsed < 0.0f)
+	else if (AFGPlayer* PreviousShooter = GetShooter())
+	{
+		PreviousShooter->OnRocketFreed(this);
+	}
+	Shooter = InShooter;
+	if (InShooter != nullptr)
+	{
+		InShooter->OnRocketFired(this);
+	}
+	CachedCollisionQueryParams.ClearIgnoredActors();
+	CachedCollisionQueryParams.AddIgnoredActor(this);
+	CachedCollisionQueryParams.AddIgnoredActor(InShooter);
+	bIsFree = false;
+	if (UFGProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UFGProjectileSubsystem>())
 	{
-		Explode();
+		ProjectileSubsystem->AddProjectile(this, InStartLocation, Forward, MovementVelocity, LifeTime, FMath::Clamp(ElapsedTime, 0.0f, LifeTime));
 	}
 }
 
-void AFGRocket::StartMoving(const FVector& Forward, const FVector& InStartLocation)
+FVector AFGRocket::GetFlightDirection() const
 {
-	FacingRotationStart = Forward;
-	FacingRotationCorrection = FacingRotationStart.ToOrientationQuat();
-	RocketStartLocation = InStartLocation;
-	SetActorLocationAndRotation(InStartLocation, Forward.Rotation());
-	bIsFree = false;
-	SetActorTickEnabled(true);
-	SetRocketVisibility(true);
-	LifeTimeElapsed = LifeTime;
-	DistanceMoved = 0.0f;
-	OrigianlFacingDirection = FacingRotationStart;
+	UFGProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UFGProjectileSubsystem>();
+	return ProjectileSubsystem != nullptr ? ProjectileSubsystem->GetDirection(this) : GetActorForwardVector();
 }
 
 void AFGRocket::ApplyCorrection(const FVector& Forward)
 {
-	FacingRotationCorrection = Forward.ToOrientationQuat();
+	if (UFGProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UFGProjectileSubsystem>())
+	{
+		ProjectileSubsystem->SetCorrection(this, Forward);
+	}
 }
 
 void AFGRocket::Explode()
 {
-	if (Explosion != nullptr)
+	UFGProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UFGProjectileSubsystem>();
+	UFGEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UFGEffectPoolSubsystem>();
+	if (Explosion != nullptr && ProjectileSubsystem != nullptr && EffectPool != nullptr)
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Explosion, GetActorLocation(), GetActorRotation(), true);
+		const FVector Location = ProjectileSubsystem->GetLocation(this);
+		const FRotator Rotation = ProjectileSubsystem->GetDirection(this).Rotation();
+		EffectPool->SpawnEffect(Explosion, Location, Rotation);
 	}
 	MakeFree();
 }
 
 void AFGRocket::MakeFree()
 {
+	if (bIsFree)
+	{
+		return;
+	}
+	if (AFGPlayer* PreviousShooter = GetShooter())
+	{
+		PreviousShooter->OnRocketFreed(this);
+	}
+	Shooter.Reset();
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+	{
+		RocketPool->ReleaseRocket(this);
+	}
+	if (UFGProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UFGProjectileSubsystem>())
+	{
+		ProjectileSubsystem->RemoveProjectile(this);
+	}
 	bIsFree = true;
-	SetActorTickEnabled(false);
-	SetRocketVisibility(false);
 }
 
 void AFGRocket::SetRocketVisibility(bool bVisible)
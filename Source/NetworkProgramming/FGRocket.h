@@ -5,6 +5,7 @@
 #include "FGRocket.generated.h"
 
 class UStaticMeshComponent;
+class AFGPlayer;
 
 UCLASS()
 class NETWORKPROGRAMMING_API AFGRocket : public AActor
@@ -14,30 +15,43 @@ public:
 	AFGRocket();
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 public:	
-	virtual void Tick(float DeltaTime) override;
-	void StartMoving(const FVector& Forward, const FVector& InStartLocation);
+	void StartMoving(const FVector& Forward, const FVector& InStartLocation, AFGPlayer* InShooter, float ElapsedTime = 0.0f);
 	void ApplyCorrection(const FVector& Forward);
 	bool IsFree() const { return bIsFree; }
+	AFGPlayer* GetShooter() const { return Shooter.Get(); }
+	int32 GetPoolIndex() const { return PoolIndex; }
+	FVector GetFlightDirection() const;
 	void Explode();
 	void MakeFree();
 	void SetRocketVisibility(bool bVisible);
+	bool TraceFlight(const FVector& Start, const FVector& End, AFGPlayer*& OutHitPlayer) const;
+	bool TraceRewound(const FVector& Start, const FVector& End, AFGPlayer*& OutHitPlayer) const;
+	bool ShouldExplodeOnHit(const FHitResult& Hit, AFGPlayer*& OutHitPlayer) const;
+	const FCollisionQueryParams& GetCollisionQueryParams() const { return CachedCollisionQueryParams; }
 	uint32 Damage = 10;
 private:
+	friend class UFGRocketPoolSubsystem;
+	friend class UFGProjectileSubsystem;
 	FCollisionQueryParams CachedCollisionQueryParams;
+	TWeakObjectPtr<AFGPlayer> Shooter;
+	AFGRocket* PreviousFreeRocket = nullptr;
+	AFGRocket* NextFreeRocket = nullptr;
+	bool bLinkedFree = false;
+	UPROPERTY(Replicated)
+	int32 PoolIndex = INDEX_NONE;
+	int32 ProjectileIndex = INDEX_NONE;
+	// Bumped every time the rocket is fired, tells results for an earlier flight apart.
+	uint32 FlightId = 0;
 	UPROPERTY(EditAnywhere, Category = VFX)
 	UParticleSystem* Explosion = nullptr;
 	UPROPERTY(EditAnywhere, Category = Mesh)
 	UStaticMeshComponent* MeshComponent = nullptr;
 	UPROPERTY(EditAnywhere, Category = Debug)
 	bool bDebugDrawCorrection = false;
-	FVector OrigianlFacingDirection = FVector::ZeroVector;
-	FVector FacingRotationStart = FVector::ZeroVector;
-	FQuat FacingRotationCorrection = FQuat::Identity;
-	FVector RocketStartLocation = FVector::ZeroVector;
 	float LifeTime = 2.0f;
-	float LifeTimeElapsed = 0.0f;
-	float DistanceMoved = 0.0f;
 	UPROPERTY(EditAnywhere, Category = VFX)
 	float MovementVelocity = 1300.0f;
 	bool bIsFree = true;
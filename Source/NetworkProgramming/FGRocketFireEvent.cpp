@@ -0,0 +1,35 @@
+#include "FGRocketFireEvent.h"
+#include "Engine/NetSerialization.h"
+
+bool FFGRocketFireEvent::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	Ar << PoolIndex;
+	bOutSuccess = SerializePackedVector<10, 24>(StartLocation, Ar);
+	const FRotator Rotation = Direction.Rotation();
+	uint16 CompressedPitch = FRotator::CompressAxisToShort(Rotation.Pitch);
+	uint16 CompressedYaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	Ar << CompressedPitch;
+	Ar << CompressedYaw;
+	uint16 FireTimeMs = static_cast<uint16>(ServerFireTimeMs & MAX_uint16);
+	Ar << FireTimeMs;
+	if (Ar.IsLoading())
+	{
+		Direction = FRotator(FRotator::DecompressAxisFromShort(CompressedPitch), FRotator::DecompressAxisFromShort(CompressedYaw), 0.0f).Vector();
+		ServerFireTimeMs = FireTimeMs;
+	}
+	return true;
+}
+
+void FFGRocketFireEvent::Quantize()
+{
+	StartLocation = FVector(FMath::RoundToFloat(StartLocation.X * 10.0f) / 10.0f, FMath::RoundToFloat(StartLocation.Y * 10.0f) / 10.0f, FMath::RoundToFloat(StartLocation.Z * 10.0f) / 10.0f);
+	const FRotator Rotation = Direction.Rotation();
+	Direction = FRotator(FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotation.Pitch)), FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotation.Yaw)), 0.0f).Vector();
+}
+
+int32 FFGRocketFireEvent::ResolveServerFireTimeMs(int32 CurrentServerTimeMs) const
+{
+	// Signed difference of the low bits, so a clock estimate slightly ahead of the fire time still resolves.
+	const int16 AgeMs = static_cast<int16>(static_cast<uint16>((CurrentServerTimeMs - ServerFireTimeMs) & MAX_uint16));
+	return CurrentServerTimeMs - AgeMs;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGRocketFireEvent.generated.h"
+
+USTRUCT()
+struct FFGRocketFireEvent
+{
+	GENERATED_BODY()
+public:
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	// Rounds the event to exactly what a receiver will get, so the sender can simulate the same flight.
+	void Quantize();
+	// Full server fire time, given a server time from within 32 seconds of it.
+	int32 ResolveServerFireTimeMs(int32 CurrentServerTimeMs) const;
+	UPROPERTY()
+	uint16 PoolIndex = 0;
+	UPROPERTY()
+	FVector StartLocation = FVector::ZeroVector;
+	UPROPERTY()
+	FVector Direction = FVector::ForwardVector;
+	UPROPERTY()
+	int32 ServerFireTimeMs = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGRocketFireEvent> : public TStructOpsTypeTraitsBase2<FFGRocketFireEvent>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,54 @@
+#include "FGTimingWheel.h"
+
+void FFGTimingWheel::Schedule(uint16 Id, uint16 Tick)
+{
+	FEntry Entry;
+	Entry.Id = Id;
+	Entry.Tick = Tick;
+	// Already overdue, fire on the next advance instead of a full turn later.
+	const uint16 SlotTick = bStarted && static_cast<int16>(Tick - LastTick) <= 0 ? static_cast<uint16>(LastTick + 1) : Tick;
+	Slots[SlotTick % NumberSlots].Add(Entry);
+}
+
+void FFGTimingWheel::Advance(uint16 CurrentTick, TArray<uint16>& OutDue)
+{
+	int32 TicksPassed = static_cast<int32>(static_cast<uint16>(CurrentTick - LastTick));
+	if (TicksPassed == 0 && bStarted)
+	{
+		return;
+	}
+	// A clock that jumped backwards would otherwise freeze the wheel until it caught up with the old tick.
+	if (!bStarted || TicksPassed > MAX_int16)
+	{
+		bStarted = true;
+		TicksPassed = 1;
+	}
+	const int32 NumberSlotsPassed = FMath::Min(TicksPassed, NumberSlots);
+	for (int32 Step = NumberSlotsPassed - 1; Step >= 0; --Step)
+	{
+		AdvanceSlot(static_cast<uint16>(CurrentTick - Step) % NumberSlots, CurrentTick, OutDue);
+	}
+	LastTick = CurrentTick;
+}
+
+void FFGTimingWheel::AdvanceSlot(int32 SlotIndex, uint16 CurrentTick, TArray<uint16>& OutDue)
+{
+	TArray<FEntry>& Slot = Slots[SlotIndex];
+	for (int32 Index = Slot.Num() - 1; Index >= 0; --Index)
+	{
+		if (static_cast<int16>(Slot[Index].Tick - CurrentTick) <= 0)
+		{
+			OutDue.Add(Slot[Index].Id);
+			Slot.RemoveAtSwap(Index, 1, false);
+		}
+	}
+}
+
+void FFGTimingWheel::Reset()
+{
+	for (TArray<FEntry>& Slot : Slots)
+	{
+		Slot.Reset();
+	}
+	bStarted = false;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FFGTimingWheel
+{
+public:
+	static const int32 NumberSlots = 64;
+	// Ids due more than NumberSlots ticks ahead stay in their slot until the wheel comes around again.
+	void Schedule(uint16 Id, uint16 Tick);
+	void Advance(uint16 CurrentTick, TArray<uint16>& OutDue);
+	void Reset();
+private:
+	struct FEntry
+	{
+		uint16 Id = 0;
+		uint16 Tick = 0;
+	};
+	void AdvanceSlot(int32 SlotIndex, uint16 CurrentTick, TArray<uint16>& OutDue);
+	TArray<FEntry> Slots[NumberSlots];
+	uint16 LastTick = 0;
+	bool bStarted = false;
+};
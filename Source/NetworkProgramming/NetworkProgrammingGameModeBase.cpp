@@ -2,4 +2,10 @@
 
 
 #include "NetworkProgrammingGameModeBase.h"
+#include "FGGameState.h"
+
+ANetworkProgrammingGameModeBase::ANetworkProgrammingGameModeBase()
+{
+	GameStateClass = AFGGameState::StaticClass();
+}
 
@@ -13,5 +13,6 @@ UCLASS()
 class NETWORKPROGRAMMING_API ANetworkProgrammingGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
-	
+public:
+	ANetworkProgrammingGameModeBase();
 };
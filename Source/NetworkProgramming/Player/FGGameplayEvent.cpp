@@ -0,0 +1,84 @@
+#include "FGGameplayEvent.h"
+#include "Engine/NetSerialization.h"
+
+bool FFGGameplayEventPacket::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	uint32 NumberEvents = FMath::Min(Events.Num(), MaxEvents);
+	Ar.SerializeInt(NumberEvents, MaxEvents + 1);
+	if (Ar.IsLoading())
+	{
+		Events.SetNum(NumberEvents);
+	}
+	if (NumberEvents == 0)
+	{
+		return true;
+	}
+	uint16 FirstSequence = Events[0].Sequence;
+	Ar << FirstSequence;
+	for (uint32 Index = 0; Index < NumberEvents; ++Index)
+	{
+		FFGGameplayEvent& Event = Events[Index];
+		Event.Sequence = FirstSequence + static_cast<uint16>(Index);
+		uint8 Type = static_cast<uint8>(Event.Type);
+		Ar.SerializeBits(&Type, 2);
+		Event.Type = static_cast<EFGGameplayEventType>(Type);
+		switch (Event.Type)
+		{
+		case EFGGameplayEventType::FireRocket:
+		{
+			bool bFireEventSuccess = true;
+			Event.FireEvent.NetSerialize(Ar, Map, bFireEventSuccess);
+			bOutSuccess &= bFireEventSuccess;
+			break;
+		}
+		case EFGGameplayEventType::RemoveRocket:
+			Ar << Event.FireEvent.PoolIndex;
+			break;
+		}
+	}
+	return true;
+}
+
+void FFGGameplayEventSender::Add(const FFGGameplayEvent& Event)
+{
+	if (Unacked.Num() >= MaxUnacked)
+	{
+		Unacked.RemoveAt(0, Unacked.Num() - MaxUnacked + 1, false);
+	}
+	FFGGameplayEvent& NewEvent = Unacked.Add_GetRef(Event);
+	NewEvent.Sequence = NextSequence++;
+}
+
+void FFGGameplayEventSender::BuildPacket(FFGGameplayEventPacket& OutPacket) const
+{
+	const int32 NumberEvents = FMath::Min(Unacked.Num(), FFGGameplayEventPacket::MaxEvents);
+	OutPacket.Events.Reset(NumberEvents);
+	OutPacket.Events.Append(Unacked.GetData(), NumberEvents);
+}
+
+void FFGGameplayEventSender::Ack(uint16 Sequence)
+{
+	int32 NumberAcked = 0;
+	while (NumberAcked < Unacked.Num() && static_cast<int16>(Unacked[NumberAcked].Sequence - Sequence) <= 0)
+	{
+		NumberAcked++;
+	}
+	Unacked.RemoveAt(0, NumberAcked, false);
+}
+
+void FFGGameplayEventReceiver::Receive(const FFGGameplayEventPacket& Packet, TArray<FFGGameplayEvent>& OutNewEvents)
+{
+	// Packets always start at the oldest unacknowledged event, so a gap in front of the new events means
+	// the sender dropped them for good and waiting for them would stall the stream forever.
+	for (const FFGGameplayEvent& Event : Packet.Events)
+	{
+		const int16 SequenceDelta = static_cast<int16>(Event.Sequence - LastAppliedSequence);
+		if (SequenceDelta <= 0)
+		{
+			continue;
+		}
+		OutNewEvents.Add(Event);
+		LastAppliedSequence = Event.Sequence;
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../FGRocketFireEvent.h"
+#include "FGGameplayEvent.generated.h"
+
+UENUM()
+enum class EFGGameplayEventType : uint8
+{
+	FireRocket,
+	RemoveRocket
+};
+
+USTRUCT()
+struct FFGGameplayEvent
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	EFGGameplayEventType Type = EFGGameplayEventType::FireRocket;
+	UPROPERTY()
+	uint16 Sequence = 0;
+	UPROPERTY()
+	FFGRocketFireEvent FireEvent;
+};
+
+USTRUCT()
+struct FFGGameplayEventPacket
+{
+	GENERATED_BODY()
+public:
+	static const int32 MaxEvents = 32;
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	UPROPERTY()
+	TArray<FFGGameplayEvent> Events;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGGameplayEventPacket> : public TStructOpsTypeTraitsBase2<FFGGameplayEventPacket>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT()
+struct FFGGameplayEventAck
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	class AFGPlayer* Subject = nullptr;
+	UPROPERTY()
+	uint16 Sequence = 0;
+};
+
+struct FFGGameplayEventSender
+{
+	static const int32 MaxUnacked = 128;
+	void Add(const FFGGameplayEvent& Event);
+	bool HasUnacked() const { return Unacked.Num() > 0; }
+	void BuildPacket(FFGGameplayEventPacket& OutPacket) const;
+	void Ack(uint16 Sequence);
+	TArray<FFGGameplayEvent> Unacked;
+	uint16 NextSequence = 1;
+};
+
+struct FFGGameplayEventReceiver
+{
+	void Receive(const FFGGameplayEventPacket& Packet, TArray<FFGGameplayEvent>& OutNewEvents);
+	uint16 LastAppliedSequence = 0;
+};
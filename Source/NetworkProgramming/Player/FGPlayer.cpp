@@ -12,10 +12,19 @@
 #include "FGPlayerSettings.h"
 #include "../Debug/UI/FGNetDebugWidget.h"
 #include "../FGPickup.h"
+#include "../FGGameState.h"
 #include "../FGRocket.h"
-#include "Kismet/GameplayStatics.h"
+#include "../Subsystems/FGClockSyncSubsystem.h"
+#include "../Subsystems/FGEffectPoolSubsystem.h"
+#include "../Subsystems/FGInterestSubsystem.h"
+#include "../Subsystems/FGLagCompensationSubsystem.h"
+#include "../Subsystems/FGPickupGridSubsystem.h"
+#include "../Subsystems/FGRocketPoolSubsystem.h"
 
 const static float MaxMoveDeltaTime = 0.125f;
+const static int32 MaxMovesPerBatch = FFGMovePacket::MaxElements;
+const static float FireDirectionToleranceDot = 0.99985f;
+const static float ResolvedPickupTimeout = 1.0f;
 
 AFGPlayer::AFGPlayer()
 {
@@ -42,10 +51,46 @@ void AFGPlayer::BeginPlay()
 	{
 		DebugMenuInstance->SetVisibility(ESlateVisibility::Collapsed);
 	}
-	SpawnRockets();
-	BP_OnNumberRocketsChanged(NumberRockets);
-	BP_OnHealthChanged(Health);
+	ReserveRockets();
+	if (UFGEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UFGEffectPoolSubsystem>())
+	{
+		EffectPool->PrewarmEffect(Explosion);
+	}
+	BP_OnNumberRocketsChanged(GetNumRockets());
+	BP_OnHealthChanged(PublicStats.Health);
 	OriginalMeshOffset = MeshComponent->GetRelativeLocation();
+	if (PlayerSettings != nullptr)
+	{
+		SnapshotBuffer.SetLimits(PlayerSettings->MinInterpolationDelay, PlayerSettings->MaxInterpolationDelay, PlayerSettings->MaxExtrapolationTime);
+	}
+	if (HasAuthority())
+	{
+		if (UFGInterestSubsystem* InterestSubsystem = GetWorld()->GetSubsystem<UFGInterestSubsystem>())
+		{
+			InterestSubsystem->RegisterPlayer(this);
+		}
+		if (UFGLagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>())
+		{
+			LagCompensationSubsystem->RegisterPlayer(this);
+		}
+	}
+}
+
+void AFGPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+	if (UFGInterestSubsystem* InterestSubsystem = GetWorld()->GetSubsystem<UFGInterestSubsystem>())
+	{
+		InterestSubsystem->UnregisterPlayer(this);
+	}
+	if (UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		ClockSyncSubsystem->RemovePlayer(this);
+	}
+	if (UFGLagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>())
+	{
+		LagCompensationSubsystem->UnregisterPlayer(this);
+	}
 }
 
 void AFGPlayer::Tick(float DeltaTime)
@@ -56,36 +101,80 @@ void AFGPlayer::Tick(float DeltaTime)
 	{
 		return;
 	}
-	FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+	if (bIsDead)
+	{
+		TickDeadNetwork(DeltaTime);
+		return;
+	}
 	if (IsLocallyControlled())
 	{
-		ClientTimeStamp += DeltaTime;
-		const float MaxVelocity = PlayerSettings->MaxVelocity;
-		const float Friction = IsBraking() ? PlayerSettings->BrakingFriction : PlayerSettings->DefaultFriction;
-		const float Alpha = FMath::Clamp(FMath::Abs(MovementVelocity / (PlayerSettings->MaxVelocity * 0.75f)), 0.0f, 1.0f);
-		const float TurnSpeed = FMath::InterpEaseOut(0.0f, PlayerSettings->TurnSpeedDefault, Alpha, 5.0f);
-		const float MovementDirection = MovementVelocity > 0.0f ? Turn : -Turn;
-		Yaw += (MovementDirection * TurnSpeed) * DeltaTime;
-		FQuat WantedFacingDirection = FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw));
-		MovementComponent->SetFacingRotation(WantedFacingDirection, 10.5f);
-		AddMovementVelocity(DeltaTime); 
-		MovementVelocity *= FMath::Pow(Friction, DeltaTime);
-		MovementComponent->ApplyGravity();
-		FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
-		MovementComponent->Move(FrameMovement); 
-		Server_SendMovement(GetActorLocation(), ClientTimeStamp, Forward, GetActorRotation().Yaw);
+		// Moves are simulated with the same millisecond and input precision the server receives them in.
+		MoveTimeRemainder = FMath::Min(MoveTimeRemainder + DeltaTime, MaxMoveDeltaTime);
+		FFGPlayerMove Move;
+		Move.DeltaTime = FFGMovePacket::QuantizeDeltaTime(MoveTimeRemainder);
+		MoveTimeRemainder -= Move.DeltaTime;
+		if (Move.DeltaTime > 0.0f)
+		{
+			ClientTimeStamp += Move.DeltaTime;
+			Move.TimeStamp = ClientTimeStamp;
+			Move.Forward = FFGMovePacket::QuantizeAxis(Forward);
+			Move.Turn = FFGMovePacket::QuantizeAxis(Turn);
+			Move.bBrake = bBrake;
+			SimulateMove(Move);
+			if (HasAuthority())
+			{
+				ServerTimeStamp = ClientTimeStamp;
+				StateBatch.Add(GetMoveState(ServerTimeStamp));
+			}
+			else
+			{
+				FFGPendingMove& PendingMove = PendingMoves.Add(FFGPendingMove());
+				PendingMove.Move = Move;
+				PendingMove.PredictedLocation = GetActorLocation();
+				MoveBatch.Add(Move);
+			}
+		}
+		if (!HasAuthority())
+		{
+			ClockSyncTimeCount += DeltaTime;
+			if (ClockSyncTimeCount >= PlayerSettings->ClockSyncInterval)
+			{
+				SendClockPing();
+			}
+			NetMessageTimeCount += DeltaTime;
+			if (NetMessageTimeCount >= GetNetSendInterval() || MoveBatch.Num() >= MaxMovesPerBatch)
+			{
+				FlushMoveBatch();
+			}
+		}
+	}
+	else if (!HasAuthority())
+	{
+		TickSimulatedProxy(DeltaTime);
 	}
-	else
+	if (HasAuthority())
 	{
-		const float Friction = IsBraking() ? PlayerSettings->BrakingFriction : PlayerSettings->DefaultFriction;
-		MovementVelocity *= FMath::Pow(Friction, DeltaTime);
-		FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
-		MovementComponent->Move(FrameMovement);
-		if (bPerformNetworkSmoothing)
+		NetMessageTimeCount += DeltaTime;
+		if (NetMessageTimeCount >= GetNetSendInterval() || StateBatch.Num() >= MaxMovesPerBatch)
 		{
-			const FVector NewRelativeLocation = FMath::VInterpTo(MeshComponent->GetRelativeLocation(), OriginalMeshOffset, LastCorrectionDelta, 0.75f);
-			MeshComponent->SetRelativeLocation(NewRelativeLocation, false, nullptr, ETeleportType::TeleportPhysics);
+			FlushStateBatch();
+			FlushGameplayEvents();
 		}
+		UFGLagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>();
+		UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+		if (LagCompensationSubsystem != nullptr && ClockSyncSubsystem != nullptr)
+		{
+			LagCompensationSubsystem->RecordPosition(this, ClockSyncSubsystem->GetServerTime(), GetActorLocation(), GetCollisionRadius());
+		}
+	}
+	if (HasAuthority() || IsLocallyControlled())
+	{
+		CollectPickups();
+	}
+	if (bPerformNetworkSmoothing && IsLocallyControlled() && !HasAuthority())
+	{
+		const FVector NewRelativeLocation = FMath::VInterpTo(MeshComponent->GetRelativeLocation(), OriginalMeshOffset, LastCorrectionDelta, 0.75f);
+		MeshComponent->SetRelativeLocation(NewRelativeLocation, false, nullptr, ETeleportType::TeleportPhysics);
 	}
 }
 
@@ -176,35 +265,356 @@ void AFGPlayer::CreateDebugWidget()
 	}
 }
 
-void AFGPlayer::Server_SendMovement_Implementation(const FVector& ClientLocation, float TimeStamp, float ClientForward, float ClientYaw)
+void AFGPlayer::Server_SendMoves_Implementation(const FFGMovePacket& ClientPacket)
 {
-	MultiCast_SendMovement(ClientLocation, TimeStamp, ClientForward, ClientYaw);
+	if (!ensure(PlayerSettings != nullptr))
+	{
+		return;
+	}
+	const int32 NumberMoves = FMath::Min(ClientPacket.Moves.Num(), MaxMovesPerBatch);
+	const float PreviousServerTimeStamp = ServerTimeStamp;
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	MoveTimeBudget = FMath::Min(MoveTimeBudget + CurrentTime - LastMoveBudgetTime, PlayerSettings->MoveTimeTolerance + GetNetSendInterval());
+	LastMoveBudgetTime = CurrentTime;
+	for (int32 Index = 0; Index < NumberMoves; ++Index)
+	{
+		ServerProcessMove(ClientPacket.Moves[Index]);
+	}
+	if (ServerTimeStamp != PreviousServerTimeStamp)
+	{
+		Client_AckMove(GetMoveState(ServerTimeStamp));
+	}
 }
 
-void AFGPlayer::MultiCast_SendMovement_Implementation(const FVector& InClientLocation, float TimeStamp, float ClientForward, float ClientYaw)
+void AFGPlayer::ServerProcessMove(const FFGPlayerMove& ClientMove)
 {
-	if (!IsLocallyControlled())
+	if (ClientMove.TimeStamp <= ServerTimeStamp)
 	{
-		Forward = ClientForward;
-		const float DeltaTime = FMath::Min(TimeStamp - ClientTimeStamp, MaxMoveDeltaTime);
-		ClientTimeStamp = TimeStamp;
-		AddMovementVelocity(DeltaTime);
-		MovementComponent->SetFacingRotation(FRotator(0.0f, ClientYaw, 0.0f));
-		const FVector DeltaDifference = InClientLocation - GetActorLocation();
-		if (DeltaDifference.SizeSquared() > FMath::Square(40.0f))
+		return;
+	}
+	FFGPlayerMove Move = ClientMove;
+	Move.DeltaTime = FMath::Clamp(Move.DeltaTime, 0.0f, FMath::Min(MaxMoveDeltaTime, MoveTimeBudget));
+	MoveTimeBudget -= Move.DeltaTime;
+	Move.Forward = FMath::Clamp(Move.Forward, -1.0f, 1.0f);
+	Move.Turn = FMath::Clamp(Move.Turn, -1.0f, 1.0f);
+	bBrake = Move.bBrake;
+	Turn = Move.Turn;
+	SimulateMove(Move);
+	ServerTimeStamp = Move.TimeStamp;
+	StateBatch.Add(GetMoveState(ServerTimeStamp));
+	if (StateBatch.Num() >= MaxMovesPerBatch)
+	{
+		FlushStateBatch();
+	}
+}
+
+void AFGPlayer::TickDeadNetwork(float DeltaTime)
+{
+	NetMessageTimeCount += DeltaTime;
+	if (NetMessageTimeCount < GetNetSendInterval())
+	{
+		return;
+	}
+	NetMessageTimeCount = 0.0f;
+	if (HasAuthority())
+	{
+		FlushGameplayEvents();
+	}
+	else if (IsLocallyControlled())
+	{
+		FlushOwnerGameplayEvents();
+		FlushAcks();
+	}
+}
+
+void AFGPlayer::FlushAcks()
+{
+	if (PendingMovementAcks.Num() > 0)
+	{
+		Server_AckMovement(PendingMovementAcks);
+		PendingMovementAcks.Reset();
+	}
+	if (PendingGameplayEventAcks.Num() > 0)
+	{
+		Server_AckGameplayEvents(PendingGameplayEventAcks);
+		PendingGameplayEventAcks.Reset();
+	}
+}
+
+void AFGPlayer::FlushMoveBatch()
+{
+	NetMessageTimeCount = 0.0f;
+	FlushOwnerGameplayEvents();
+	FlushAcks();
+	if (MoveBatch.Num() == 0)
+	{
+		return;
+	}
+	FFGMovePacket Packet;
+	Packet.BaseTimeStamp = LastSentTimeStamp;
+	Packet.Moves = MoveBatch;
+	LastSentTimeStamp = MoveBatch.Last().TimeStamp;
+	Server_SendMoves(Packet);
+	MoveBatch.Reset();
+}
+
+void AFGPlayer::FlushStateBatch()
+{
+	NetMessageTimeCount = 0.0f;
+	if (StateBatch.Num() == 0)
+	{
+		return;
+	}
+	UFGInterestSubsystem* InterestSubsystem = GetWorld()->GetSubsystem<UFGInterestSubsystem>();
+	if (InterestSubsystem == nullptr)
+	{
+		StateBatch.Reset();
+		return;
+	}
+	const TArray<FFGPlayerMoveState> NewestStates = { StateBatch.Last() };
+	TArray<FFGInterestViewer> Viewers;
+	InterestSubsystem->GatherViewers(this, PlayerSettings->NearInterestDistance, PlayerSettings->MidInterestDistance, PlayerSettings->BehindViewDot, Viewers);
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	for (const FFGInterestViewer& InterestViewer : Viewers)
+	{
+		if (InterestViewer.Tier == EFGInterestTier::Near)
 		{
-			if (bPerformNetworkSmoothing)
-			{
-				const FScopedPreventAttachedComponentMove PreventMeshMove(MeshComponent);
-				MovementComponent->UpdatedComponent->SetWorldLocation(InClientLocation, false, nullptr, ETeleportType::TeleportPhysics);
-				LastCorrectionDelta = DeltaTime;
-			}
-			else
-			{
-				SetActorLocation(InClientLocation);
-			}
+			SendMovementToViewer(InterestViewer.Viewer, StateBatch, CurrentTime);
+			continue;
+		}
+		const float TierRate = InterestViewer.Tier == EFGInterestTier::Mid ? PlayerSettings->MidInterestRate : PlayerSettings->FarInterestRate;
+		const FFGViewerMovementChannel* Channel = ViewerChannels.Find(InterestViewer.Viewer);
+		if (Channel == nullptr || CurrentTime - Channel->LastSendTime >= 1.0f / TierRate)
+		{
+			SendMovementToViewer(InterestViewer.Viewer, NewestStates, CurrentTime);
 		}
 	}
+	StateBatch.Reset();
+}
+
+void AFGPlayer::SendClockPing()
+{
+	ClockSyncTimeCount = 0.0f;
+	if (const UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		Server_ClockPing(ClockSyncSubsystem->GetLocalTimeMs(), FMath::RoundToInt(ClockSyncSubsystem->GetLocalStats().ViewDelay * 1000.0));
+	}
+}
+
+void AFGPlayer::Server_ClockPing_Implementation(int32 ClientTimeMs, int32 ViewDelayMs)
+{
+	if (!ensure(PlayerSettings != nullptr))
+	{
+		return;
+	}
+	if (UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		const float ViewDelay = FMath::Clamp(static_cast<float>(ViewDelayMs) / 1000.0f, 0.0f, PlayerSettings->MaxInterpolationDelay);
+		ClockSyncSubsystem->OnPingReceived(this, ViewDelay);
+		Client_ClockPong(ClientTimeMs, ClockSyncSubsystem->GetServerTimeMs());
+	}
+}
+
+void AFGPlayer::Client_ClockPong_Implementation(int32 ClientTimeMs, int32 ServerTimeMs)
+{
+	if (UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		ClockSyncSubsystem->OnPongReceived(ClientTimeMs, ServerTimeMs);
+		Server_ClockPongEcho(ServerTimeMs);
+	}
+}
+
+void AFGPlayer::Server_ClockPongEcho_Implementation(int32 ServerTimeMs)
+{
+	if (UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		ClockSyncSubsystem->OnPongEchoReceived(this, ServerTimeMs);
+	}
+}
+
+float AFGPlayer::GetNetSendInterval() const
+{
+	return PlayerSettings != nullptr ? 1.0f / PlayerSettings->NetSendRate : 0.0f;
+}
+
+void AFGPlayer::Client_AckMove_Implementation(const FFGPlayerMoveState& ServerState)
+{
+	if (!ensure(PlayerSettings != nullptr))
+	{
+		return;
+	}
+	int32 NumberAcked = 0;
+	while (NumberAcked < PendingMoves.Num() && PendingMoves[NumberAcked].Move.TimeStamp < ServerState.TimeStamp)
+	{
+		NumberAcked++;
+	}
+	if (NumberAcked < PendingMoves.Num())
+	{
+		if (PendingMoves[NumberAcked].Move.TimeStamp != ServerState.TimeStamp)
+		{
+			return;
+		}
+		const FVector PredictionError = ServerState.Location - PendingMoves[NumberAcked].PredictedLocation;
+		PendingMoves.PopFront(NumberAcked + 1);
+		if (PredictionError.SizeSquared() <= FMath::Square(PlayerSettings->MaxPredictionError))
+		{
+			return;
+		}
+	}
+	else
+	{
+		PendingMoves.Reset();
+	}
+	const float SavedForward = Forward;
+	const FVector PreviousLocation = GetActorLocation();
+	{
+		const FScopedPreventAttachedComponentMove PreventMeshMove(bPerformNetworkSmoothing ? MeshComponent : nullptr);
+		MovementComponent->UpdatedComponent->SetWorldLocation(ServerState.Location, false, nullptr, ETeleportType::TeleportPhysics);
+		Yaw = ServerState.Yaw;
+		MovementVelocity = ServerState.MovementVelocity;
+		for (int32 Index = 0; Index < PendingMoves.Num(); ++Index)
+		{
+			SimulateMove(PendingMoves[Index].Move);
+			PendingMoves[Index].PredictedLocation = GetActorLocation();
+		}
+	}
+	Forward = SavedForward;
+	if (bPerformNetworkSmoothing)
+	{
+		MeshComponent->SetRelativeLocation(OriginalMeshOffset + (PreviousLocation - GetActorLocation()), false, nullptr, ETeleportType::TeleportPhysics);
+		LastCorrectionDelta = GetWorld()->GetDeltaSeconds();
+	}
+}
+
+void AFGPlayer::SendMovementToViewer(AFGPlayer* Viewer, const TArray<FFGPlayerMoveState>& States, float CurrentTime)
+{
+	// Every packet needs its own sequence, the baseline of a packet is its last state.
+	for (int32 FirstState = 0; FirstState < States.Num(); FirstState += FFGMovePacket::MaxElements)
+	{
+		const int32 NumberStates = FMath::Min(States.Num() - FirstState, FFGMovePacket::MaxElements);
+		SendMovementPacket(Viewer, TArray<FFGPlayerMoveState>(States.GetData() + FirstState, NumberStates), CurrentTime);
+	}
+}
+
+void AFGPlayer::SendMovementPacket(AFGPlayer* Viewer, const TArray<FFGPlayerMoveState>& States, float CurrentTime)
+{
+	FFGViewerMovementChannel& Channel = ViewerChannels.FindOrAdd(Viewer);
+	FFGMovePacket Packet;
+	Packet.BaseTimeStamp = States[0].TimeStamp;
+	Packet.LocationQuantization = PlayerSettings->MovePacketLocationQuantization;
+	Packet.States = States;
+	Packet.Sequence = Channel.NextSequence++;
+	// Only reference baselines the viewer still remembers, otherwise the packet could never be decoded.
+	const uint16 BaselineAge = Packet.Sequence - Channel.AckedBaseline.Sequence;
+	if (!Channel.bHasAckedBaseline || BaselineAge > Channel.SentBaselines.Max() || CurrentTime - Channel.LastKeyframeTime >= PlayerSettings->MovementKeyframeInterval)
+	{
+		Packet.BaselineOffset = 0;
+		Channel.LastKeyframeTime = CurrentTime;
+	}
+	else
+	{
+		Packet.BaselineOffset = static_cast<uint8>(BaselineAge);
+	}
+	Packet.QuantizeStates(Channel.AckedBaseline.Location);
+	FFGMoveBaseline& SentBaseline = Channel.SentBaselines.Add(FFGMoveBaseline());
+	SentBaseline.Sequence = Packet.Sequence;
+	SentBaseline.Location = Packet.States.Last().Location;
+	Channel.LastSendTime = CurrentTime;
+	Viewer->Client_SendMovementBatch(this, Packet);
+}
+
+void AFGPlayer::Client_SendMovementBatch_Implementation(AFGPlayer* Subject, const FFGMovePacket& ServerPacket)
+{
+	if (Subject != nullptr)
+	{
+		Subject->ReceiveMovementBatch(this, ServerPacket);
+	}
+}
+
+void AFGPlayer::ReceiveMovementBatch(AFGPlayer* Viewer, const FFGMovePacket& ServerPacket)
+{
+	if (IsLocallyControlled() || HasAuthority() || ServerPacket.States.Num() == 0)
+	{
+		return;
+	}
+	FVector BaselineLocation = FVector::ZeroVector;
+	if (!ServerPacket.IsKeyframe())
+	{
+		const uint16 BaselineSequence = ServerPacket.GetBaselineSequence();
+		int32 BaselineIndex = ReceivedBaselines.Num() - 1;
+		while (BaselineIndex >= 0 && ReceivedBaselines[BaselineIndex].Sequence != BaselineSequence)
+		{
+			BaselineIndex--;
+		}
+		if (BaselineIndex < 0)
+		{
+			return;
+		}
+		BaselineLocation = ReceivedBaselines[BaselineIndex].Location;
+	}
+	FFGMovePacket Packet = ServerPacket;
+	Packet.ResolveStates(BaselineLocation);
+	FFGMoveBaseline& ReceivedBaseline = ReceivedBaselines.Add(FFGMoveBaseline());
+	ReceivedBaseline.Sequence = Packet.Sequence;
+	ReceivedBaseline.Location = Packet.States.Last().Location;
+	FFGMovementAck& Ack = Viewer->PendingMovementAcks.AddDefaulted_GetRef();
+	Ack.Subject = this;
+	Ack.Sequence = Packet.Sequence;
+	SnapshotBuffer.AddSnapshots(Packet.States, GetWorld()->GetTimeSeconds(), GetNetSendInterval());
+}
+
+void AFGPlayer::Server_AckMovement_Implementation(const TArray<FFGMovementAck>& Acks)
+{
+	const int32 NumberAcks = FMath::Min(Acks.Num(), 64);
+	for (int32 Index = 0; Index < NumberAcks; ++Index)
+	{
+		if (Acks[Index].Subject != nullptr)
+		{
+			Acks[Index].Subject->OnMovementAcked(this, Acks[Index].Sequence);
+		}
+	}
+}
+
+void AFGPlayer::OnMovementAcked(AFGPlayer* Viewer, uint16 Sequence)
+{
+	FFGViewerMovementChannel* Channel = ViewerChannels.Find(Viewer);
+	if (Channel == nullptr)
+	{
+		return;
+	}
+	if (Channel->bHasAckedBaseline && static_cast<int16>(Sequence - Channel->AckedBaseline.Sequence) <= 0)
+	{
+		return;
+	}
+	for (int32 Index = 0; Index < Channel->SentBaselines.Num(); ++Index)
+	{
+		if (Channel->SentBaselines[Index].Sequence == Sequence)
+		{
+			Channel->AckedBaseline = Channel->SentBaselines[Index];
+			Channel->bHasAckedBaseline = true;
+			return;
+		}
+	}
+}
+
+void AFGPlayer::TickSimulatedProxy(float DeltaTime)
+{
+	FFGPlayerMoveState RenderState;
+	const bool bHasState = bPerformNetworkSmoothing ? SnapshotBuffer.Sample(GetWorld()->GetTimeSeconds(), DeltaTime, RenderState) : SnapshotBuffer.GetNewest(RenderState);
+	if (!bHasState)
+	{
+		return;
+	}
+	if (UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		ClockSyncSubsystem->ReportViewDelay(bPerformNetworkSmoothing ? SnapshotBuffer.GetInterpolationDelay() : 0.0f);
+	}
+	Forward = RenderState.Forward;
+	bBrake = RenderState.bBrake;
+	Yaw = RenderState.Yaw;
+	const FRotator RenderRotation(0.0f, RenderState.Yaw, 0.0f);
+	MovementComponent->SetFacingRotation(RenderRotation);
+	SetActorLocationAndRotation(RenderState.Location, RenderRotation);
 }
 
 void AFGPlayer::AddMovementVelocity(float DeltaTime)
@@ -219,6 +629,41 @@ void AFGPlayer::AddMovementVelocity(float DeltaTime)
 	MovementVelocity = FMath::Clamp(MovementVelocity, -MaxVelocity, MaxVelocity);
 }
 
+void AFGPlayer::SimulateMove(const FFGPlayerMove& Move)
+{
+	if (!ensure(PlayerSettings != nullptr))
+	{
+		return;
+	}
+	const float Friction = Move.bBrake ? PlayerSettings->BrakingFriction : PlayerSettings->DefaultFriction;
+	const float Alpha = FMath::Clamp(FMath::Abs(MovementVelocity / (PlayerSettings->MaxVelocity * 0.75f)), 0.0f, 1.0f);
+	const float TurnSpeed = FMath::InterpEaseOut(0.0f, PlayerSettings->TurnSpeedDefault, Alpha, 5.0f);
+	const float MovementDirection = MovementVelocity > 0.0f ? Move.Turn : -Move.Turn;
+	Yaw += (MovementDirection * TurnSpeed) * Move.DeltaTime;
+	const FQuat WantedFacingDirection = FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw));
+	MovementComponent->SetFacingRotation(WantedFacingDirection, 10.5f);
+	Forward = Move.Forward;
+	AddMovementVelocity(Move.DeltaTime);
+	MovementVelocity *= FMath::Pow(Friction, Move.DeltaTime);
+	MovementComponent->ApplyGravity(Move.DeltaTime);
+	// Move along the simulated yaw rather than the smoothed actor rotation so replays end up where the server did.
+	FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+	FrameMovement.AddDelta(WantedFacingDirection.GetForwardVector() * MovementVelocity * Move.DeltaTime);
+	MovementComponent->Move(FrameMovement);
+}
+
+FFGPlayerMoveState AFGPlayer::GetMoveState(float TimeStamp) const
+{
+	FFGPlayerMoveState State;
+	State.TimeStamp = TimeStamp;
+	State.Location = GetActorLocation();
+	State.Yaw = Yaw;
+	State.MovementVelocity = MovementVelocity;
+	State.Forward = Forward;
+	State.bBrake = bBrake;
+	return State;
+}
+
 void AFGPlayer::Server_SendLocation_Implementation(const FVector& LocationToSend)
 {
 	ReplicatedLocation = LocationToSend;
@@ -233,11 +678,97 @@ void AFGPlayer::OnPickup(AFGPickup* Pickup)
 {
 	if (HasAuthority())
 	{
-		Server_OnPickup(Pickup);
+		Server_OnPickup(Pickup, 0);
 	}
 	else if (IsLocallyControlled())
 	{
-		Pickup->SetVisibility(false);
+		PredictPickup(Pickup);
+	}
+}
+
+void AFGPlayer::PredictPickup(AFGPickup* Pickup)
+{
+	if (PredictedPickups.ContainsByPredicate([Pickup](const FFGPredictedPickup& Predicted) { return Predicted.Pickup == Pickup; }))
+	{
+		return;
+	}
+	if (NextPickupPredictionKey == 0)
+	{
+		NextPickupPredictionKey++;
+	}
+	FFGPredictedPickup& Predicted = PredictedPickups.AddDefaulted_GetRef();
+	Predicted.Pickup = Pickup;
+	Predicted.PredictionKey = NextPickupPredictionKey++;
+	if (Pickup->PickupType == EFGPickupType::Rocket)
+	{
+		Predicted.NumberRockets = Pickup->NumberRockets;
+	}
+	else if (Pickup->PickupType == EFGPickupType::Health)
+	{
+		Predicted.Health = Pickup->HealthValue;
+	}
+	Pickup->SetVisibility(false);
+	Server_OnPickup(Pickup, Predicted.PredictionKey);
+	BP_OnHealthChanged(GetHealth());
+	BP_OnNumberRocketsChanged(GetNumRockets());
+}
+
+void AFGPlayer::ResolvePredictedPickups()
+{
+	int32 NumberResolved = 0;
+	while (NumberResolved < PredictedPickups.Num() && OwnerStats.IsPickupResolved(PredictedPickups[NumberResolved].PredictionKey))
+	{
+		const FFGPredictedPickup& Predicted = PredictedPickups[NumberResolved++];
+		AFGPickup* Pickup = Predicted.Pickup.Get();
+		if (Pickup == nullptr)
+		{
+			continue;
+		}
+		// Until the game state says it is taken the pickup still looks available here, touching it again must not
+		// predict it a second time, whether the server took it for us or turned us down.
+		FFGResolvedPickup& Resolved = ResolvedPickups.AddDefaulted_GetRef();
+		Resolved.Pickup = Pickup;
+		Resolved.ResolveTime = GetWorld()->GetTimeSeconds();
+		bool bAccepted = false;
+		if (!(OwnerStats.GetPickupResult(Predicted.PredictionKey, bAccepted) && bAccepted))
+		{
+			Pickup->SetVisibility(Pickup->IsAvailable());
+		}
+	}
+	PredictedPickups.RemoveAt(0, NumberResolved, false);
+}
+
+bool AFGPlayer::IsPickupInReach(const AFGPickup* Pickup) const
+{
+	if (Pickup == nullptr || PlayerSettings == nullptr || bIsDead)
+	{
+		return false;
+	}
+	const float Tolerance = PlayerSettings->MaxVelocity * (GetNetSendInterval() + PlayerSettings->PickupTimeTolerance);
+	const float Reach = GetCollisionRadius() + Pickup->GetRadius() + Tolerance;
+	return FVector::DistSquared(GetActorLocation(), Pickup->GetActorLocation()) <= FMath::Square(Reach);
+}
+
+void AFGPlayer::CollectPickups()
+{
+	UFGPickupGridSubsystem* PickupGrid = GetWorld()->GetSubsystem<UFGPickupGridSubsystem>();
+	if (PickupGrid == nullptr || bIsDead)
+	{
+		return;
+	}
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	ResolvedPickups.RemoveAllSwap([CurrentTime](const FFGResolvedPickup& Resolved)
+	{
+		const AFGPickup* Pickup = Resolved.Pickup.Get();
+		return Pickup == nullptr || !Pickup->IsAvailable() || CurrentTime - Resolved.ResolveTime > ResolvedPickupTimeout;
+	}, false);
+	PickupGrid->GatherPickups(GetActorLocation(), GetCollisionRadius(), NearbyPickups);
+	for (AFGPickup* Pickup : NearbyPickups)
+	{
+		if (Pickup->IsAvailable() && !ResolvedPickups.ContainsByPredicate([Pickup](const FFGResolvedPickup& Resolved) { return Resolved.Pickup == Pickup; }))
+		{
+			OnPickup(Pickup);
+		}
 	}
 }
 
@@ -251,92 +782,134 @@ void AFGPlayer::OnHit(AFGRocket* Rocket)
 
 void AFGPlayer::Die()
 {
+	bIsDead = true;
+	if (HasAuthority())
+	{
+		if (UFGLagCompensationSubsystem* LagCompensationSubsystem = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>())
+		{
+			LagCompensationSubsystem->UnregisterPlayer(this);
+		}
+	}
 	Explode();
 	BP_OnEnd(false);
 	SetActorHiddenInGame(true);
 	CollisionComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	SetActorTickEnabled(false);
 }
 
 void AFGPlayer::Explode()
 {
-	if (Explosion != nullptr)
+	if (UFGEffectPoolSubsystem* EffectPool = GetWorld()->GetSubsystem<UFGEffectPoolSubsystem>())
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Explosion, GetActorLocation(), GetActorRotation(), true);
+		EffectPool->SpawnEffect(Explosion, GetActorLocation(), GetActorRotation());
 	}
 }
 
-void AFGPlayer::Server_OnPickup_Implementation(AFGPickup* Pickup)
+void AFGPlayer::Server_OnPickup_Implementation(AFGPickup* Pickup, uint16 PredictionKey)
 {
+	AFGGameState* GameState = GetWorld()->GetGameState<AFGGameState>();
+	const bool bAccepted = GameState != nullptr && IsPickupInReach(Pickup) && GameState->ConsumePickup(Pickup);
+	if (PredictionKey != 0)
+	{
+		OwnerStats.RecordPickupResult(PredictionKey, bAccepted);
+	}
+	if (!bAccepted)
+	{
+		return;
+	}
 	if (Pickup->PickupType == EFGPickupType::Rocket)
 	{
-		ServerNumberRockets += Pickup->NumberRockets;
-		MultiCast_UpdateStat(Pickup, ServerNumberRockets);
-		MultiCast_OnPickup(Pickup);
+		OwnerStats.NumberRockets = FMath::Min(OwnerStats.NumberRockets + Pickup->NumberRockets, FFGPlayerStats::MaxValue);
+		OnRep_OwnerStats();
 	}
 	else if (Pickup->PickupType == EFGPickupType::Health)
 	{
-		ServerHealth += Pickup->HealthValue;
-		MultiCast_UpdateStat(Pickup, ServerHealth);
-		MultiCast_OnPickup(Pickup);
+		PublicStats.Health = FMath::Min(PublicStats.Health + Pickup->HealthValue, FFGPlayerStats::MaxValue);
+		OnRep_PublicStats();
 	}
 }
 
 void AFGPlayer::Server_OnHit_Implementation(uint32 DamageToSend)
 {
-	ServerHealth -= DamageToSend;
-	MultiCast_OnHit(DamageToSend);
+	PublicStats.Health -= DamageToSend;
+	OnRep_PublicStats();
 }
 
-void AFGPlayer::MultiCast_OnPickup_Implementation(AFGPickup* Pickup)
+void AFGPlayer::OnRep_PublicStats()
 {
-	if (Pickup->PickupType == EFGPickupType::Rocket)
+	// Accepted pickups are resolved by whichever stats arrive last, so their health is not counted on top of the prediction.
+	const int32 NumberPredictedPickups = PredictedPickups.Num();
+	ResolvePredictedPickups();
+	if (PredictedPickups.Num() != NumberPredictedPickups)
 	{
-		NumberRockets += Pickup->NumberRockets;
-		Pickup->RestartPickup();
+		BP_OnNumberRocketsChanged(GetNumRockets());
 	}
-	else if (Pickup->PickupType == EFGPickupType::Health)
+	BP_OnHealthChanged(GetHealth());
+	if (PublicStats.Health <= 0 && !bIsDead)
 	{
-		Health += Pickup->HealthValue;
-		Pickup->RestartPickup();
+		Die();
 	}
 }
 
-void AFGPlayer::MultiCast_OnHit_Implementation(uint32 DamageToSend)
+void AFGPlayer::OnRep_OwnerStats()
 {
-	Health -= DamageToSend;
-	BP_OnHealthChanged(Health);
-	if (Health <= 0)
+	const int32 NumberPredictedPickups = PredictedPickups.Num();
+	ResolvePredictedPickups();
+	BP_OnNumberRocketsChanged(GetNumRockets());
+	if (PredictedPickups.Num() != NumberPredictedPickups)
 	{
-		Die();
+		BP_OnHealthChanged(GetHealth());
 	}
 }
 
-void AFGPlayer::SpawnRockets()
+int32 AFGPlayer::GetNumRockets() const
 {
-	if (HasAuthority() && RocketClass != nullptr)
+	int32 NumberRockets = OwnerStats.NumberRockets - PredictedRockets.Num();
+	for (const FFGPredictedPickup& Predicted : PredictedPickups)
 	{
-		const int32 RocketCache = 8;
-		for (int32 Index = 0; Index < RocketCache; ++Index)
-		{
-			FActorSpawnParameters SpawnParameters;
-			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-			SpawnParameters.ObjectFlags = RF_Transient;
-			SpawnParameters.Instigator = this;
-			SpawnParameters.Owner = this;
-			AFGRocket* NewRocketInstance = GetWorld()->SpawnActor<AFGRocket>(RocketClass, GetActorLocation(), GetActorRotation(), SpawnParameters);
-			RocketInstances.Add(NewRocketInstance);
-		}
+		NumberRockets += Predicted.NumberRockets;
+	}
+	return FMath::Clamp(NumberRockets, 0, FFGPlayerStats::MaxValue);
+}
+
+int32 AFGPlayer::GetHealth() const
+{
+	int32 Health = PublicStats.Health;
+	for (const FFGPredictedPickup& Predicted : PredictedPickups)
+	{
+		Health += Predicted.Health;
+	}
+	return FMath::Min(Health, FFGPlayerStats::MaxValue);
+}
+
+void AFGPlayer::ReserveRockets()
+{
+	if (!HasAuthority())
+	{
+		return;
+	}
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+	{
+		RocketPool->EnsureFreeRockets(RocketClass);
 	}
 }
 
+void AFGPlayer::OnRocketFired(AFGRocket* Rocket)
+{
+	NumberActiveRockets++;
+}
+
+void AFGPlayer::OnRocketFreed(AFGRocket* Rocket)
+{
+	NumberActiveRockets = FMath::Max(NumberActiveRockets - 1, 0);
+}
+
 void AFGPlayer::FireRocket()
 {
 	if (FireCooldownElapsed > 0.0f)
 	{
 		return;
 	}
-	if (NumberRockets <= 0 && !bUnlimitedRockets)
+	if (GetNumRockets() <= 0 && !bUnlimitedRockets)
 	{
 		return;
 	}
@@ -345,119 +918,287 @@ void AFGPlayer::FireRocket()
 		return;
 	}
 	AFGRocket* NewRocket = GetFreeRocket();
-	if (!ensure(NewRocket != nullptr))
+	if (NewRocket == nullptr || NewRocket->GetPoolIndex() == INDEX_NONE)
 	{
 		return;
 	}
 	FireCooldownElapsed = PlayerSettings->FireCooldown;
 	if (GetLocalRole() >= ROLE_AutonomousProxy)
 	{
+		FFGRocketFireEvent FireEvent;
+		FireEvent.PoolIndex = static_cast<uint16>(NewRocket->GetPoolIndex());
+		FireEvent.StartLocation = GetRocketStartLocation();
+		FireEvent.Direction = GetActorForwardVector();
+		FireEvent.Quantize();
 		if (HasAuthority())
 		{
-			Server_FireRocket(NewRocket, GetRocketStartLocation(), GetActorRotation());
-			BP_OnNumberRocketsChanged(NumberRockets);
+			ServerFireRocket(FireEvent);
 		}
 		else
 		{
-			NumberRockets--;
-			NewRocket->StartMoving(GetActorForwardVector(), GetRocketStartLocation());
-			Server_FireRocket(NewRocket, GetRocketStartLocation(), GetActorRotation());
-			BP_OnNumberRocketsChanged(NumberRockets);
+			NewRocket->StartMoving(FireEvent.Direction, FireEvent.StartLocation, this);
+			PredictedRockets.Add(NewRocket);
+			FFGGameplayEvent Event;
+			Event.Type = EFGGameplayEventType::FireRocket;
+			Event.FireEvent = FireEvent;
+			OwnerEventSender.Add(Event);
+			BP_OnNumberRocketsChanged(GetNumRockets());
 		}
 	}
 }
 
-void AFGPlayer::Server_FireRocket_Implementation(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& RocketFacingRotation)
+void AFGPlayer::ServerFireRocket(const FFGRocketFireEvent& ClientFireEvent)
 {
-	if ((ServerNumberRockets - 1) < 0 && !bUnlimitedRockets)
+	UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>();
+	AFGRocket* RequestedRocket = RocketPool != nullptr ? RocketPool->GetRocketByIndex(ClientFireEvent.PoolIndex) : nullptr;
+	AFGRocket* ServerRocket = RequestedRocket != nullptr && RequestedRocket->IsFree() ? RequestedRocket : GetFreeRocket();
+	if (((OwnerStats.NumberRockets - 1) < 0 && !bUnlimitedRockets) || ServerRocket == nullptr)
 	{
-		Client_RemoveRocket(NewRocket, ServerNumberRockets);
+		FFGGameplayEvent Event;
+		Event.Type = EFGGameplayEventType::RemoveRocket;
+		Event.FireEvent.PoolIndex = ClientFireEvent.PoolIndex;
+		SendGameplayEvent(Event, true);
 	}
 	else
 	{
+		const FRotator RocketFacingRotation = ClientFireEvent.Direction.Rotation();
 		const float DeltaYaw = FMath::FindDeltaAngleDegrees(RocketFacingRotation.Yaw, GetActorForwardVector().Rotation().Yaw);
 		const FRotator NewFacingRotation = RocketFacingRotation + FRotator(0.0f, DeltaYaw, 0.0f);
-		ServerNumberRockets--;
-		MultiCast_FireRocket(NewRocket, RocketStartLocation, NewFacingRotation);
+		FFGRocketFireEvent FireEvent = ClientFireEvent;
+		FireEvent.PoolIndex = static_cast<uint16>(ServerRocket->GetPoolIndex());
+		FireEvent.Direction = NewFacingRotation.Vector();
+		UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+		FireEvent.ServerFireTimeMs = ClockSyncSubsystem != nullptr ? ClockSyncSubsystem->GetServerTimeMs() : 0;
+		FireEvent.Quantize();
+		if (!bUnlimitedRockets)
+		{
+			OwnerStats.NumberRockets--;
+			OnRep_OwnerStats();
+		}
+		FFGGameplayEvent Event;
+		Event.Type = EFGGameplayEventType::FireRocket;
+		Event.FireEvent = FireEvent;
+		SendGameplayEvent(Event, false);
+		ReserveRockets();
 	}
 }
 
-void AFGPlayer::MultiCast_FireRocket_Implementation(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& RocketFacingRotation)
+void AFGPlayer::ApplyFireRocket(const FFGRocketFireEvent& FireEvent)
 {
+	UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>();
+	AFGRocket* NewRocket = RocketPool != nullptr ? RocketPool->GetRocketByIndex(FireEvent.PoolIndex) : nullptr;
 	if (!ensure(NewRocket != nullptr))
 	{
 		return;
 	}
+	const float ElapsedTime = GetFireEventAge(FireEvent);
 	if (GetLocalRole() == ROLE_AutonomousProxy)
 	{
-		NewRocket->ApplyCorrection(RocketFacingRotation.Vector());
+		AFGRocket* PredictedRocket = PredictedRockets.Num() > 0 ? PredictedRockets[0] : nullptr;
+		if (PredictedRockets.Num() > 0)
+		{
+			PredictedRockets.RemoveAt(0);
+		}
+		if (NewRocket == PredictedRocket)
+		{
+			if (FVector::DotProduct(NewRocket->GetFlightDirection(), FireEvent.Direction) < FireDirectionToleranceDot)
+			{
+				NewRocket->ApplyCorrection(FireEvent.Direction);
+			}
+		}
+		else
+		{
+			if (PredictedRocket != nullptr && PredictedRocket->GetShooter() == this)
+			{
+				PredictedRocket->MakeFree();
+			}
+			NewRocket->StartMoving(FireEvent.Direction, FireEvent.StartLocation, this, ElapsedTime);
+		}
 	}
 	else
 	{
-		NumberRockets--;
-		NewRocket->StartMoving(RocketFacingRotation.Vector(), RocketStartLocation);
+		NewRocket->StartMoving(FireEvent.Direction, FireEvent.StartLocation, this, ElapsedTime);
+	}
+	if (IsLocallyControlled())
+	{
+		BP_OnNumberRocketsChanged(GetNumRockets());
 	}
-	BP_OnNumberRocketsChanged(NumberRockets);
 }
 
-void AFGPlayer::MultiCast_UpdateStat_Implementation(AFGPickup* Pickup, uint32 InStat)
+float AFGPlayer::GetFireEventAge(const FFGRocketFireEvent& FireEvent) const
 {
-	if (Pickup->PickupType == EFGPickupType::Rocket)
+	UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+	if (HasAuthority() || ClockSyncSubsystem == nullptr || ClockSyncSubsystem->GetLocalStats().NumberSamples == 0)
 	{
-		BP_OnNumberRocketsChanged(InStat);
+		return 0.0f;
 	}
-	else if (Pickup->PickupType == EFGPickupType::Health)
+	const int32 ServerTimeMs = ClockSyncSubsystem->GetServerTimeMs();
+	return FMath::Max(ServerTimeMs - FireEvent.ResolveServerFireTimeMs(ServerTimeMs), 0) / 1000.0f;
+}
+
+void AFGPlayer::ApplyRemoveRocket(uint16 PoolIndex)
+{
+	if (PredictedRockets.Num() > 0)
+	{
+		PredictedRockets.RemoveAt(0);
+	}
+	UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>();
+	AFGRocket* RocketToRemove = RocketPool != nullptr ? RocketPool->GetRocketByIndex(PoolIndex) : nullptr;
+	if (RocketToRemove != nullptr && RocketToRemove->GetShooter() == this)
 	{
-		BP_OnHealthChanged(InStat);
+		RocketToRemove->MakeFree();
 	}
+	BP_OnNumberRocketsChanged(GetNumRockets());
 }
 
-void AFGPlayer::Client_RemoveRocket_Implementation(AFGRocket* RocketToRemove, uint32 InNumberRockets)
+void AFGPlayer::SendGameplayEvent(const FFGGameplayEvent& Event, bool bOwnerOnly)
 {
-	RocketToRemove->MakeFree();
-	NumberRockets = InNumberRockets;
+	if (bOwnerOnly)
+	{
+		if (IsLocallyControlled())
+		{
+			ApplyGameplayEvent(Event);
+		}
+		else
+		{
+			EventChannels.FindOrAdd(this).Add(Event);
+		}
+		return;
+	}
+	ApplyGameplayEvent(Event);
+	if (UFGInterestSubsystem* InterestSubsystem = GetWorld()->GetSubsystem<UFGInterestSubsystem>())
+	{
+		for (AFGPlayer* Viewer : InterestSubsystem->GetPlayers())
+		{
+			if (Viewer != nullptr && !Viewer->IsLocallyControlled() && Viewer->GetNetConnection() != nullptr)
+			{
+				EventChannels.FindOrAdd(Viewer).Add(Event);
+			}
+		}
+	}
 }
 
-FVector AFGPlayer::GetRocketStartLocation() const
+void AFGPlayer::FlushGameplayEvents()
 {
-	const FVector StartLocation = GetActorLocation() + GetActorForwardVector() * 100.0f;
-	return StartLocation;
+	for (auto It = EventChannels.CreateIterator(); It; ++It)
+	{
+		AFGPlayer* Viewer = It.Key().Get();
+		if (Viewer == nullptr)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+		if (It.Value().HasUnacked())
+		{
+			FFGGameplayEventPacket Packet;
+			It.Value().BuildPacket(Packet);
+			Viewer->Client_SendGameplayEvents(this, Packet);
+		}
+	}
 }
 
-int32 AFGPlayer::GetNumberActiveRockets() const
+void AFGPlayer::FlushOwnerGameplayEvents()
 {
-	int32 NumberActive = 0;
-	for (AFGRocket* Rocket : RocketInstances)
+	if (OwnerEventSender.HasUnacked())
 	{
-		if (!Rocket->IsFree())
+		FFGGameplayEventPacket Packet;
+		OwnerEventSender.BuildPacket(Packet);
+		Server_SendGameplayEvents(Packet);
+	}
+}
+
+void AFGPlayer::Server_SendGameplayEvents_Implementation(const FFGGameplayEventPacket& ClientPacket)
+{
+	TArray<FFGGameplayEvent> NewEvents;
+	OwnerEventReceiver.Receive(ClientPacket, NewEvents);
+	for (const FFGGameplayEvent& Event : NewEvents)
+	{
+		if (Event.Type == EFGGameplayEventType::FireRocket)
 		{
-			NumberActive++;
+			ServerFireRocket(Event.FireEvent);
 		}
 	}
-	return NumberActive;
+	Client_AckGameplayEvents(OwnerEventReceiver.LastAppliedSequence);
 }
 
-AFGRocket* AFGPlayer::GetFreeRocket() const
+void AFGPlayer::Client_AckGameplayEvents_Implementation(uint16 Sequence)
 {
-	for (AFGRocket* Rocket : RocketInstances)
+	OwnerEventSender.Ack(Sequence);
+}
+
+void AFGPlayer::Client_SendGameplayEvents_Implementation(AFGPlayer* Subject, const FFGGameplayEventPacket& ServerPacket)
+{
+	if (Subject != nullptr)
 	{
-		if (Rocket == nullptr)
+		Subject->ReceiveGameplayEvents(this, ServerPacket);
+	}
+}
+
+void AFGPlayer::ReceiveGameplayEvents(AFGPlayer* Viewer, const FFGGameplayEventPacket& ServerPacket)
+{
+	if (HasAuthority())
+	{
+		return;
+	}
+	TArray<FFGGameplayEvent> NewEvents;
+	EventReceiver.Receive(ServerPacket, NewEvents);
+	for (const FFGGameplayEvent& Event : NewEvents)
+	{
+		ApplyGameplayEvent(Event);
+	}
+	// Duplicates are acknowledged as well, the previous ack may have been the packet that got lost.
+	FFGGameplayEventAck& Ack = Viewer->PendingGameplayEventAcks.AddDefaulted_GetRef();
+	Ack.Subject = this;
+	Ack.Sequence = EventReceiver.LastAppliedSequence;
+}
+
+void AFGPlayer::Server_AckGameplayEvents_Implementation(const TArray<FFGGameplayEventAck>& Acks)
+{
+	const int32 NumberAcks = FMath::Min(Acks.Num(), 64);
+	for (int32 Index = 0; Index < NumberAcks; ++Index)
+	{
+		if (Acks[Index].Subject == nullptr)
 		{
 			continue;
 		}
-		if (Rocket->IsFree())
+		if (FFGGameplayEventSender* Channel = Acks[Index].Subject->EventChannels.Find(this))
 		{
-			return Rocket;
+			Channel->Ack(Acks[Index].Sequence);
 		}
 	}
-	return nullptr;
+}
+
+void AFGPlayer::ApplyGameplayEvent(const FFGGameplayEvent& Event)
+{
+	switch (Event.Type)
+	{
+	case EFGGameplayEventType::FireRocket:
+		ApplyFireRocket(Event.FireEvent);
+		break;
+	case EFGGameplayEventType::RemoveRocket:
+		ApplyRemoveRocket(Event.FireEvent.PoolIndex);
+		break;
+	}
+}
+
+FVector AFGPlayer::GetRocketStartLocation() const
+{
+	const FVector StartLocation = GetActorLocation() + GetActorForwardVector() * 100.0f;
+	return StartLocation;
+}
+
+AFGRocket* AFGPlayer::GetFreeRocket() const
+{
+	UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>();
+	return RocketPool != nullptr ? RocketPool->GetFreeRocket() : nullptr;
 }
 
 void AFGPlayer::Cheat_IncreaseRockets(int32 InNumberRockets)
 {
-	if(IsLocallyControlled())
+	if (HasAuthority())
 	{
-		NumberRockets += InNumberRockets;
+		OwnerStats.NumberRockets = FMath::Clamp(OwnerStats.NumberRockets + InNumberRockets, 0, FFGPlayerStats::MaxValue);
+		OnRep_OwnerStats();
 	}
 }
 
@@ -466,11 +1207,29 @@ void AFGPlayer::GetLifetimeReplicatedProps(TArray<FLifetimeProperty >& OutLifeti
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	DOREPLIFETIME(AFGPlayer, ReplicatedYaw);
 	DOREPLIFETIME(AFGPlayer, ReplicatedLocation);
-	DOREPLIFETIME(AFGPlayer, RocketInstances);
+	DOREPLIFETIME(AFGPlayer, PublicStats);
+	DOREPLIFETIME_CONDITION(AFGPlayer, OwnerStats, COND_OwnerOnly);
+}
+
+float AFGPlayer::GetCollisionRadius() const
+{
+	return CollisionComponent->GetScaledSphereRadius();
+}
+
+FVector AFGPlayer::GetViewDirection() const
+{
+	return GetActorForwardVector();
 }
 
 int32 AFGPlayer::GetPing() const
 {
+	if (const UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		if (const FFGClockSyncStats* Stats = ClockSyncSubsystem->GetStats(this))
+		{
+			return FMath::RoundToInt(Stats->RoundTripTime * 1000.0);
+		}
+	}
 	if (GetPlayerState())
 	{
 		return static_cast<int32>(GetPlayerState()->GetPing());
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "GameFramework/Pawn.h"
+#include "FGPlayerMove.h"
+#include "FGGameplayEvent.h"
+#include "FGPlayerStats.h"
+#include "FGSnapshotBuffer.h"
+#include "../FGRingBuffer.h"
 #include "FGPlayer.generated.h"
 
 class UCameraComponent;
@@ -22,6 +27,7 @@ public:
 	~AFGPlayer();
 protected:
 	virtual void BeginPlay();
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 public:
 	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
@@ -29,20 +35,20 @@ public:
 	bool IsBraking() const { return bBrake; }
 	UFUNCTION(BlueprintPure)
 	int32 GetPing() const;
+	float GetCollisionRadius() const;
+	FVector GetViewDirection() const;
 	UFUNCTION(Server, Unreliable)
 	void Server_SendLocation(const FVector& LocationToSend);
 	UFUNCTION(Server, Reliable)
-	void Server_OnPickup(AFGPickup* Pickup);
+	void Server_OnPickup(AFGPickup* Pickup, uint16 PredictionKey);
 	UFUNCTION(Server, Reliable)
 	void Server_OnHit(uint32 DamageToSend);
-	UFUNCTION(NetMulticast, Reliable)
-	void MultiCast_OnPickup(AFGPickup* Pickup);
-	UFUNCTION(NetMulticast, Reliable)
-	void MultiCast_OnHit(uint32 DamageToSend);
 	UFUNCTION(Server, Unreliable)
 	void Server_SendYaw(float NewYaw);
 	UFUNCTION(BlueprintPure)
-	int32 GetNumRockets() const { return NumberRockets; }
+	int32 GetNumRockets() const;
+	UFUNCTION(BlueprintPure)
+	int32 GetHealth() const;
 	UFUNCTION(BlueprintImplementableEvent, Category = Player, meta = (DisplayName = "On Number Rockets Changed"))
 	void BP_OnNumberRocketsChanged(int32 NewNumberRockets);
 	UFUNCTION(BlueprintImplementableEvent, Category = Player, meta = (DisplayName = "On Health Changed"))
@@ -50,12 +56,18 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = Player, meta = (DisplayName = "On Death"))
 	void BP_OnEnd(bool Winner);
 	void OnPickup(AFGPickup* Pickup);
+	void CollectPickups();
+	void PredictPickup(AFGPickup* Pickup);
+	void ResolvePredictedPickups();
+	bool IsPickupInReach(const AFGPickup* Pickup) const;
 	void OnHit(AFGRocket* Rocket);
 	void ShowDebugMenu();
 	void HideDebugMenu();
-	int32 GetNumberActiveRockets() const;
+	int32 GetNumberActiveRockets() const { return NumberActiveRockets; }
 	void FireRocket();
-	void SpawnRockets();
+	void ReserveRockets();
+	void OnRocketFired(AFGRocket* Rocket);
+	void OnRocketFreed(AFGRocket* Rocket);
 public:
 	UPROPERTY(EditAnywhere, Category = Settings)
 	UFGPlayerSettings* PlayerSettings = nullptr;
@@ -63,17 +75,27 @@ public:
 	TSubclassOf<UFGNetDebugWidget> DebugMenuClass;
 private:
 	UFUNCTION(Server, Unreliable)
-	void Server_SendMovement(const FVector& ClientLocation, float TimeStamp, float ClientForward, float ClientYaw);
-	UFUNCTION(NetMulticast, Unreliable)
-	void MultiCast_SendMovement(const FVector& InClientLocation, float TimeStamp, float ClientForward, float ClientYaw);
-	UFUNCTION(Server, Reliable)
-	void Server_FireRocket(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& RocketFacingRotation);
-	UFUNCTION(NetMulticast, Reliable)
-	void MultiCast_FireRocket(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& RocketFacingRotation);
-	UFUNCTION(Client, Reliable)
-	void Client_RemoveRocket(AFGRocket* RocketToRemove, uint32 InNumberRockets);
-	UFUNCTION(NetMulticast, Reliable)
-	void MultiCast_UpdateStat(AFGPickup* Pickup, uint32 InStat);
+	void Server_SendMoves(const FFGMovePacket& ClientPacket);
+	UFUNCTION(Client, Unreliable)
+	void Client_AckMove(const FFGPlayerMoveState& ServerState);
+	UFUNCTION(Client, Unreliable)
+	void Client_SendMovementBatch(AFGPlayer* Subject, const FFGMovePacket& ServerPacket);
+	UFUNCTION(Server, Unreliable)
+	void Server_AckMovement(const TArray<FFGMovementAck>& Acks);
+	UFUNCTION(Server, Unreliable)
+	void Server_ClockPing(int32 ClientTimeMs, int32 ViewDelayMs);
+	UFUNCTION(Client, Unreliable)
+	void Client_ClockPong(int32 ClientTimeMs, int32 ServerTimeMs);
+	UFUNCTION(Server, Unreliable)
+	void Server_ClockPongEcho(int32 ServerTimeMs);
+	UFUNCTION(Server, Unreliable)
+	void Server_SendGameplayEvents(const FFGGameplayEventPacket& ClientPacket);
+	UFUNCTION(Client, Unreliable)
+	void Client_AckGameplayEvents(uint16 Sequence);
+	UFUNCTION(Client, Unreliable)
+	void Client_SendGameplayEvents(AFGPlayer* Subject, const FFGGameplayEventPacket& ServerPacket);
+	UFUNCTION(Server, Unreliable)
+	void Server_AckGameplayEvents(const TArray<FFGGameplayEventAck>& Acks);
 	UFUNCTION(BlueprintCallable)
 	void Cheat_IncreaseRockets(int32 InNumberRockets);
 	void Handle_Acceleration(float Value);
@@ -86,7 +108,34 @@ private:
 	void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const;
 	FVector GetRocketStartLocation() const;
 	AFGRocket* GetFreeRocket() const;
+	float GetFireEventAge(const FFGRocketFireEvent& FireEvent) const;
+	void SendGameplayEvent(const FFGGameplayEvent& Event, bool bOwnerOnly);
+	void FlushGameplayEvents();
+	void FlushOwnerGameplayEvents();
+	void ReceiveGameplayEvents(AFGPlayer* Viewer, const FFGGameplayEventPacket& ServerPacket);
+	void ApplyGameplayEvent(const FFGGameplayEvent& Event);
+	void ServerFireRocket(const FFGRocketFireEvent& ClientFireEvent);
+	void ApplyFireRocket(const FFGRocketFireEvent& FireEvent);
+	void ApplyRemoveRocket(uint16 PoolIndex);
+	UFUNCTION()
+	void OnRep_PublicStats();
+	UFUNCTION()
+	void OnRep_OwnerStats();
 	void AddMovementVelocity(float DeltaTime);
+	void SimulateMove(const FFGPlayerMove& Move);
+	FFGPlayerMoveState GetMoveState(float TimeStamp) const;
+	void ServerProcessMove(const FFGPlayerMove& ClientMove);
+	void FlushMoveBatch();
+	void FlushAcks();
+	void TickDeadNetwork(float DeltaTime);
+	void SendClockPing();
+	void FlushStateBatch();
+	void SendMovementToViewer(AFGPlayer* Viewer, const TArray<FFGPlayerMoveState>& States, float CurrentTime);
+	void SendMovementPacket(AFGPlayer* Viewer, const TArray<FFGPlayerMoveState>& States, float CurrentTime);
+	void ReceiveMovementBatch(AFGPlayer* Viewer, const FFGMovePacket& ServerPacket);
+	void OnMovementAcked(AFGPlayer* Viewer, uint16 Sequence);
+	void TickSimulatedProxy(float DeltaTime);
+	float GetNetSendInterval() const;
 	void Die();
 	void Explode();
 private:
@@ -102,8 +151,12 @@ private:
 	UCameraComponent* CameraComponent;
 	UPROPERTY(EditAnywhere, Category = Movement)
 	UFGMovementComponent* MovementComponent;
-	UPROPERTY(Replicated, Transient)
-	TArray<AFGRocket*> RocketInstances;
+	UPROPERTY(Transient)
+	TArray<AFGRocket*> PredictedRockets;
+	TArray<FFGPredictedPickup> PredictedPickups;
+	TArray<FFGResolvedPickup> ResolvedPickups;
+	uint16 NextPickupPredictionKey = 1;
+	TArray<AFGPickup*> NearbyPickups;
 	UPROPERTY(EditAnywhere, Category = Weapon)
 	TSubclassOf<AFGRocket> RocketClass;
 	UPROPERTY(EditAnywhere, Category = Weapon)
@@ -118,11 +171,13 @@ private:
 	bool bPerformNetworkSmoothing = true;
 	FVector OriginalMeshOffset = FVector::ZeroVector;
 	int32 MaxActiveRockets = 3;
+	int32 NumberActiveRockets = 0;
 	float FireCooldownElapsed = 0.0f;
-	int32 ServerNumberRockets = 0;
-	int32 NumberRockets = 0;
-	int32 ServerHealth = 100;
-	int32 Health = 100;
+	UPROPERTY(ReplicatedUsing = OnRep_PublicStats)
+	FFGPlayerStats PublicStats = FFGPlayerStats(FFGPlayerStats::HealthField);
+	UPROPERTY(ReplicatedUsing = OnRep_OwnerStats)
+	FFGPlayerStats OwnerStats = FFGPlayerStats(FFGPlayerStats::NumberRocketsField | FFGPlayerStats::PickupKeyField);
+	bool bIsDead = false;
 	bool bShowDebugMenu = false;
 	float Forward = 0.0f;
 	float Turn = 0.0f;
@@ -130,8 +185,25 @@ private:
 	float Yaw = 0.0f;
 	float CurrentDeltaTime = 0.0f;
 	float NetMessageTimeCount = 0.0f;
+	float MoveTimeRemainder = 0.0f;
+	float ClockSyncTimeCount = BIG_NUMBER;
+	float LastSentTimeStamp = 0.0f;
 	bool bBrake = false;
 	float ClientTimeStamp = 0.0f;
 	float LastCorrectionDelta = 0.0f;
 	float ServerTimeStamp = 0.0f;
+	float MoveTimeBudget = 0.0f;
+	float LastMoveBudgetTime = 0.0f;
+	TFGRingBuffer<FFGPendingMove, 128> PendingMoves;
+	FFGSnapshotBuffer SnapshotBuffer;
+	TMap<TWeakObjectPtr<AFGPlayer>, FFGViewerMovementChannel> ViewerChannels;
+	TFGRingBuffer<FFGMoveBaseline, 32> ReceivedBaselines;
+	TArray<FFGMovementAck> PendingMovementAcks;
+	TArray<FFGPlayerMove> MoveBatch;
+	TArray<FFGPlayerMoveState> StateBatch;
+	TMap<TWeakObjectPtr<AFGPlayer>, FFGGameplayEventSender> EventChannels;
+	FFGGameplayEventReceiver EventReceiver;
+	FFGGameplayEventSender OwnerEventSender;
+	FFGGameplayEventReceiver OwnerEventReceiver;
+	TArray<FFGGameplayEventAck> PendingGameplayEventAcks;
 };
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "FGPlayerMove.h"
+#include "Engine/NetSerialization.h"
+
+namespace
+{
+	void SerializeAxis(FArchive& Ar, float& Value)
+	{
+		int8 QuantizedValue = static_cast<int8>(FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 127.0f));
+		Ar << QuantizedValue;
+		Value = static_cast<float>(QuantizedValue) / 127.0f;
+	}
+
+	void SerializeBool(FArchive& Ar, bool& bValue)
+	{
+		uint8 Bit = bValue ? 1 : 0;
+		Ar.SerializeBits(&Bit, 1);
+		bValue = Bit != 0;
+	}
+
+	void SerializeTimeStamp(FArchive& Ar, float& PreviousTimeStamp, float& TimeStamp)
+	{
+		uint8 DeltaTimeMs = static_cast<uint8>(FMath::Clamp(FMath::RoundToInt((TimeStamp - PreviousTimeStamp) * 1000.0f), 0, 255));
+		Ar << DeltaTimeMs;
+		if (Ar.IsLoading())
+		{
+			TimeStamp = PreviousTimeStamp + static_cast<float>(DeltaTimeMs) / 1000.0f;
+		}
+		PreviousTimeStamp = TimeStamp;
+	}
+
+	bool SerializeLocation(FArchive& Ar, FVector& Location, EFGLocationQuantization Quantization)
+	{
+		switch (Quantization)
+		{
+		case EFGLocationQuantization::Quantize:
+			return SerializePackedVector<1, 20>(Location, Ar);
+		case EFGLocationQuantization::Quantize10:
+			return SerializePackedVector<10, 24>(Location, Ar);
+		default:
+			return SerializePackedVector<100, 30>(Location, Ar);
+		}
+	}
+}
+
+bool FFGMovePacket::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	bool bHasStates = States.Num() > 0;
+	SerializeBool(Ar, bHasStates);
+	Ar << BaseTimeStamp;
+	const int32 NumberToSave = bHasStates ? States.Num() : Moves.Num();
+	// Senders split anything longer, what gets cut here would be missing from the baseline the sender remembers.
+	ensureMsgf(Ar.IsLoading() || NumberToSave <= MaxElements, TEXT("Move packet with %d elements truncated to %d."), NumberToSave, MaxElements);
+	uint32 NumberElements = FMath::Min(NumberToSave, MaxElements);
+	Ar.SerializeInt(NumberElements, MaxElements + 1);
+	float PreviousTimeStamp = BaseTimeStamp;
+	if (!bHasStates)
+	{
+		if (Ar.IsLoading())
+		{
+			Moves.SetNum(NumberElements);
+		}
+		for (uint32 Index = 0; Index < NumberElements; ++Index)
+		{
+			FFGPlayerMove& Move = Moves[Index];
+			SerializeTimeStamp(Ar, PreviousTimeStamp, Move.TimeStamp);
+			if (Ar.IsLoading())
+			{
+				Move.DeltaTime = QuantizeDeltaTime(Move.TimeStamp - (Index == 0 ? BaseTimeStamp : Moves[Index - 1].TimeStamp));
+			}
+			SerializeAxis(Ar, Move.Forward);
+			SerializeAxis(Ar, Move.Turn);
+			SerializeBool(Ar, Move.bBrake);
+		}
+		return true;
+	}
+	uint8 Quantization = static_cast<uint8>(LocationQuantization);
+	Ar.SerializeBits(&Quantization, 2);
+	LocationQuantization = static_cast<EFGLocationQuantization>(Quantization);
+	Ar << Sequence;
+	Ar << BaselineOffset;
+	if (Ar.IsLoading())
+	{
+		States.SetNum(NumberElements);
+	}
+	FVector PreviousLocation = BaselineLocationForSave;
+	for (uint32 Index = 0; Index < NumberElements; ++Index)
+	{
+		FFGPlayerMoveState& State = States[Index];
+		SerializeTimeStamp(Ar, PreviousTimeStamp, State.TimeStamp);
+		FVector LocationDelta = QuantizeLocation(State.Location - PreviousLocation, LocationQuantization);
+		bOutSuccess &= SerializeLocation(Ar, LocationDelta, LocationQuantization);
+		if (Ar.IsLoading())
+		{
+			State.Location = LocationDelta;
+		}
+		else
+		{
+			PreviousLocation = State.Location;
+		}
+		bool bYawChanged = Index == 0 || State.Yaw != States[Index - 1].Yaw;
+		if (Index > 0)
+		{
+			SerializeBool(Ar, bYawChanged);
+		}
+		if (bYawChanged)
+		{
+			uint16 CompressedYaw = FRotator::CompressAxisToShort(State.Yaw);
+			Ar << CompressedYaw;
+			State.Yaw = FRotator::DecompressAxisFromShort(CompressedYaw);
+		}
+		else if (Ar.IsLoading())
+		{
+			State.Yaw = States[Index - 1].Yaw;
+		}
+		SerializeAxis(Ar, State.Forward);
+		SerializeBool(Ar, State.bBrake);
+	}
+	return true;
+}
+
+void FFGMovePacket::QuantizeStates(const FVector& BaselineLocation)
+{
+	BaselineLocationForSave = IsKeyframe() ? FVector::ZeroVector : BaselineLocation;
+	FVector PreviousLocation = BaselineLocationForSave;
+	for (FFGPlayerMoveState& State : States)
+	{
+		PreviousLocation += QuantizeLocation(State.Location - PreviousLocation, LocationQuantization);
+		State.Location = PreviousLocation;
+		State.Yaw = FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(State.Yaw));
+		State.Forward = QuantizeAxis(State.Forward);
+	}
+}
+
+void FFGMovePacket::ResolveStates(const FVector& BaselineLocation)
+{
+	FVector PreviousLocation = IsKeyframe() ? FVector::ZeroVector : BaselineLocation;
+	for (FFGPlayerMoveState& State : States)
+	{
+		PreviousLocation += State.Location;
+		State.Location = PreviousLocation;
+	}
+}
+
+float FFGMovePacket::QuantizeAxis(float Value)
+{
+	return static_cast<float>(FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 127.0f)) / 127.0f;
+}
+
+float FFGMovePacket::QuantizeDeltaTime(float DeltaTime)
+{
+	return static_cast<float>(FMath::Clamp(FMath::RoundToInt(DeltaTime * 1000.0f), 0, MaxDeltaTimeMs)) / 1000.0f;
+}
+
+FVector FFGMovePacket::QuantizeLocation(const FVector& Location, EFGLocationQuantization Quantization)
+{
+	const float Scale = Quantization == EFGLocationQuantization::Quantize ? 1.0f : (Quantization == EFGLocationQuantization::Quantize10 ? 10.0f : 100.0f);
+	return FVector(FMath::RoundToFloat(Location.X * Scale) / Scale, FMath::RoundToFloat(Location.Y * Scale) / Scale, FMath::RoundToFloat(Location.Z * Scale) / Scale);
+}
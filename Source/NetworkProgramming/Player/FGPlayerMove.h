@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../FGRingBuffer.h"
+#include "FGPlayerMove.generated.h"
+
+UENUM()
+enum class EFGLocationQuantization : uint8
+{
+	Quantize,
+	Quantize10,
+	Quantize100
+};
+
+USTRUCT()
+struct FFGPlayerMove
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	float TimeStamp = 0.0f;
+	UPROPERTY()
+	float DeltaTime = 0.0f;
+	UPROPERTY()
+	float Forward = 0.0f;
+	UPROPERTY()
+	float Turn = 0.0f;
+	UPROPERTY()
+	bool bBrake = false;
+};
+
+USTRUCT()
+struct FFGPlayerMoveState
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	float TimeStamp = 0.0f;
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+	UPROPERTY()
+	float Yaw = 0.0f;
+	UPROPERTY()
+	float MovementVelocity = 0.0f;
+	UPROPERTY()
+	float Forward = 0.0f;
+	UPROPERTY()
+	bool bBrake = false;
+};
+
+// The first state is a delta from the acknowledged packet BaselineOffset sequences back, or from the origin when zero.
+USTRUCT()
+struct FFGMovePacket
+{
+	GENERATED_BODY()
+public:
+	static const int32 MaxElements = 32;
+	static const int32 MaxDeltaTimeMs = 125;
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	static float QuantizeAxis(float Value);
+	static float QuantizeDeltaTime(float DeltaTime);
+	static FVector QuantizeLocation(const FVector& Location, EFGLocationQuantization Quantization);
+	// Sender side, rounds the states to exactly what the receiver will reconstruct.
+	void QuantizeStates(const FVector& BaselineLocation);
+	void ResolveStates(const FVector& BaselineLocation);
+	bool IsKeyframe() const { return BaselineOffset == 0; }
+	uint16 GetBaselineSequence() const { return Sequence - BaselineOffset; }
+	UPROPERTY()
+	float BaseTimeStamp = 0.0f;
+	UPROPERTY()
+	uint16 Sequence = 0;
+	UPROPERTY()
+	uint8 BaselineOffset = 0;
+	UPROPERTY()
+	EFGLocationQuantization LocationQuantization = EFGLocationQuantization::Quantize10;
+	UPROPERTY()
+	TArray<FFGPlayerMove> Moves;
+	UPROPERTY()
+	TArray<FFGPlayerMoveState> States;
+private:
+	FVector BaselineLocationForSave = FVector::ZeroVector;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGMovePacket> : public TStructOpsTypeTraitsBase2<FFGMovePacket>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+USTRUCT()
+struct FFGMovementAck
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+	class AFGPlayer* Subject = nullptr;
+	UPROPERTY()
+	uint16 Sequence = 0;
+};
+
+struct FFGMoveBaseline
+{
+	uint16 Sequence = 0;
+	FVector Location = FVector::ZeroVector;
+};
+
+struct FFGViewerMovementChannel
+{
+	TFGRingBuffer<FFGMoveBaseline, 16> SentBaselines;
+	FFGMoveBaseline AckedBaseline;
+	float LastSendTime = -BIG_NUMBER;
+	float LastKeyframeTime = -BIG_NUMBER;
+	uint16 NextSequence = 1;
+	bool bHasAckedBaseline = false;
+};
+
+struct FFGPendingMove
+{
+	FFGPlayerMove Move;
+	FVector PredictedLocation = FVector::ZeroVector;
+};
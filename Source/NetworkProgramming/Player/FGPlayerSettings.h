@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataAsset.h"
+#include "FGPlayerMove.h"
 #include "FGPlayerSettings.generated.h"
 
 UCLASS()
@@ -23,4 +24,34 @@ public:
 	float BrakingFriction = 0.001f;
 	UPROPERTY(EditAnywhere, Category = Fire, meta = (ClampMin = 0.0f))
 	float FireCooldown = 0.15f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0f))
+	float MaxPredictionError = 10.0f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0f))
+	float MoveTimeTolerance = 0.25f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0f))
+	float PickupTimeTolerance = 0.1f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 1.0f, ClampMax = 120.0f))
+	float NetSendRate = 30.0f;
+	UPROPERTY(EditAnywhere, Category = Network)
+	EFGLocationQuantization MovePacketLocationQuantization = EFGLocationQuantization::Quantize10;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.05f))
+	float ClockSyncInterval = 0.5f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.1f))
+	float MovementKeyframeInterval = 2.0f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0f))
+	float MinInterpolationDelay = 0.05f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0f))
+	float MaxInterpolationDelay = 0.3f;
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0f))
+	float MaxExtrapolationTime = 0.25f;
+	UPROPERTY(EditAnywhere, Category = Interest, meta = (ClampMin = 0.0f))
+	float NearInterestDistance = 3000.0f;
+	UPROPERTY(EditAnywhere, Category = Interest, meta = (ClampMin = 0.0f))
+	float MidInterestDistance = 8000.0f;
+	UPROPERTY(EditAnywhere, Category = Interest, meta = (ClampMin = 0.1f))
+	float MidInterestRate = 10.0f;
+	UPROPERTY(EditAnywhere, Category = Interest, meta = (ClampMin = 0.1f))
+	float FarInterestRate = 2.0f;
+	UPROPERTY(EditAnywhere, Category = Interest, meta = (ClampMin = -1.0f, ClampMax = 1.0f))
+	float BehindViewDot = 0.0f;
 };
\ No newline at end of file
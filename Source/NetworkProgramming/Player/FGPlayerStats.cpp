@@ -0,0 +1,56 @@
+#include "FGPlayerStats.h"
+#include "Engine/NetSerialization.h"
+
+namespace
+{
+	void SerializeStat(FArchive& Ar, int32& Value)
+	{
+		uint32 PackedValue = static_cast<uint32>(FMath::Clamp(Value, 0, FFGPlayerStats::MaxValue));
+		Ar.SerializeInt(PackedValue, FFGPlayerStats::MaxValue + 1);
+		Value = static_cast<int32>(PackedValue);
+	}
+}
+
+bool FFGPlayerStats::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = true;
+	Ar.SerializeBits(&Fields, 3);
+	Fields &= HealthField | NumberRocketsField | PickupKeyField;
+	if (Fields & HealthField)
+	{
+		SerializeStat(Ar, Health);
+	}
+	if (Fields & NumberRocketsField)
+	{
+		SerializeStat(Ar, NumberRockets);
+	}
+	if (Fields & PickupKeyField)
+	{
+		Ar << LastPickupKey;
+		Ar << PickupResults;
+	}
+	return true;
+}
+
+void FFGPlayerStats::RecordPickupResult(uint16 PredictionKey, bool bAccepted)
+{
+	const int32 Shift = static_cast<int16>(PredictionKey - LastPickupKey);
+	if (Shift <= 0)
+	{
+		return;
+	}
+	PickupResults = Shift >= NumberPickupResults ? 0 : static_cast<uint16>(PickupResults << Shift);
+	PickupResults |= bAccepted ? 1 : 0;
+	LastPickupKey = PredictionKey;
+}
+
+bool FFGPlayerStats::GetPickupResult(uint16 PredictionKey, bool& bOutAccepted) const
+{
+	const int32 Age = static_cast<int16>(LastPickupKey - PredictionKey);
+	if (Age < 0 || Age >= NumberPickupResults)
+	{
+		return false;
+	}
+	bOutAccepted = (PickupResults & (1 << Age)) != 0;
+	return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGPlayerStats.generated.h"
+
+class AFGPickup;
+
+USTRUCT()
+struct FFGPlayerStats
+{
+	GENERATED_BODY()
+public:
+	static const uint8 HealthField = 1 << 0;
+	static const uint8 NumberRocketsField = 1 << 1;
+	static const uint8 PickupKeyField = 1 << 2;
+	static const int32 NumberPickupResults = 16;
+	static const int32 MaxValue = (1 << 10) - 1;
+	FFGPlayerStats() = default;
+	explicit FFGPlayerStats(uint8 InFields) : Fields(InFields) {}
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+	void RecordPickupResult(uint16 PredictionKey, bool bAccepted);
+	bool IsPickupResolved(uint16 PredictionKey) const { return static_cast<int16>(PredictionKey - LastPickupKey) <= 0; }
+	bool GetPickupResult(uint16 PredictionKey, bool& bOutAccepted) const;
+	UPROPERTY()
+	uint8 Fields = 0;
+	UPROPERTY()
+	int32 Health = 100;
+	UPROPERTY()
+	int32 NumberRockets = 0;
+	// Newest prediction key the server answered, bit N of PickupResults says if key LastPickupKey - N was accepted.
+	UPROPERTY()
+	uint16 LastPickupKey = 0;
+	UPROPERTY()
+	uint16 PickupResults = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGPlayerStats> : public TStructOpsTypeTraitsBase2<FFGPlayerStats>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
+
+struct FFGPredictedPickup
+{
+	TWeakObjectPtr<AFGPickup> Pickup;
+	uint16 PredictionKey = 0;
+	int32 Health = 0;
+	int32 NumberRockets = 0;
+};
+
+struct FFGResolvedPickup
+{
+	TWeakObjectPtr<AFGPickup> Pickup;
+	float ResolveTime = 0.0f;
+};
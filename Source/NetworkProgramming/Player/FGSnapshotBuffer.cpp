@@ -0,0 +1,93 @@
+#include "FGSnapshotBuffer.h"
+
+const static float TimeOffsetDecay = 0.01f;
+const static float JitterSmoothing = 0.1f;
+const static float SnapshotIntervalSmoothing = 0.25f;
+const static float MaxDelayChangeRate = 0.1f;
+
+void FFGSnapshotBuffer::SetLimits(float InMinDelay, float InMaxDelay, float InMaxExtrapolationTime)
+{
+	MinDelay = InMinDelay;
+	MaxDelay = FMath::Max(InMinDelay, InMaxDelay);
+	MaxExtrapolationTime = InMaxExtrapolationTime;
+}
+
+void FFGSnapshotBuffer::AddSnapshots(const TArray<FFGPlayerMoveState>& States, float LocalTime, float SendInterval)
+{
+	const float PreviousNewestTimeStamp = Snapshots.IsEmpty() ? 0.0f : Snapshots.Last().TimeStamp;
+	for (const FFGPlayerMoveState& State : States)
+	{
+		if (Snapshots.IsEmpty() || State.TimeStamp > Snapshots.Last().TimeStamp)
+		{
+			Snapshots.Add(State);
+		}
+	}
+	if (Snapshots.IsEmpty())
+	{
+		return;
+	}
+	const float OffsetSample = Snapshots.Last().TimeStamp - LocalTime;
+	if (!bHasTimeOffset)
+	{
+		TimeOffset = OffsetSample;
+		InterpolationDelay = FMath::Clamp(SendInterval, MinDelay, MaxDelay);
+		SnapshotInterval = SendInterval;
+		bHasTimeOffset = true;
+	}
+	else if (Snapshots.Last().TimeStamp > PreviousNewestTimeStamp)
+	{
+		SnapshotInterval += (Snapshots.Last().TimeStamp - PreviousNewestTimeStamp - SnapshotInterval) * SnapshotIntervalSmoothing;
+	}
+	// The offset follows the earliest arrivals, anything later than that is jitter.
+	TimeOffset = OffsetSample > TimeOffset ? OffsetSample : TimeOffset + (OffsetSample - TimeOffset) * TimeOffsetDecay;
+	Jitter += (FMath::Abs(OffsetSample - TimeOffset) - Jitter) * JitterSmoothing;
+	// States arriving further apart than the delay limits allow for still have to be interpolated, not extrapolated.
+	const float Interval = FMath::Max(SendInterval, SnapshotInterval);
+	TargetInterpolationDelay = FMath::Clamp(Interval + Jitter * 2.0f, MinDelay, FMath::Max(MaxDelay, Interval + MinDelay));
+}
+
+bool FFGSnapshotBuffer::Sample(float LocalTime, float DeltaTime, FFGPlayerMoveState& OutState)
+{
+	if (Snapshots.IsEmpty())
+	{
+		return false;
+	}
+	const float MaxDelayChange = MaxDelayChangeRate * DeltaTime;
+	InterpolationDelay += FMath::Clamp(TargetInterpolationDelay - InterpolationDelay, -MaxDelayChange, MaxDelayChange);
+	const float RenderTime = LocalTime + TimeOffset - InterpolationDelay;
+	while (Snapshots.Num() >= 2 && Snapshots[1].TimeStamp <= RenderTime)
+	{
+		Snapshots.PopFront();
+	}
+	const FFGPlayerMoveState& From = Snapshots.First();
+	if (RenderTime <= From.TimeStamp)
+	{
+		OutState = From;
+		return true;
+	}
+	if (Snapshots.Num() >= 2)
+	{
+		const FFGPlayerMoveState& To = Snapshots[1];
+		const float SnapshotDuration = To.TimeStamp - From.TimeStamp;
+		const float Alpha = (RenderTime - From.TimeStamp) / SnapshotDuration;
+		OutState = To;
+		OutState.Location = FMath::Lerp(From.Location, To.Location, Alpha);
+		OutState.Yaw = From.Yaw + FMath::FindDeltaAngleDegrees(From.Yaw, To.Yaw) * Alpha;
+		ExtrapolationVelocity = (To.Location - From.Location) / SnapshotDuration;
+		return true;
+	}
+	const float ExtrapolationTime = FMath::Min(RenderTime - From.TimeStamp, MaxExtrapolationTime);
+	OutState = From;
+	OutState.Location = From.Location + ExtrapolationVelocity * ExtrapolationTime;
+	return true;
+}
+
+bool FFGSnapshotBuffer::GetNewest(FFGPlayerMoveState& OutState) const
+{
+	if (Snapshots.IsEmpty())
+	{
+		return false;
+	}
+	OutState = Snapshots.Last();
+	return true;
+}
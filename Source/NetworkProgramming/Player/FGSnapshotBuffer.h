@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGPlayerMove.h"
+#include "../FGRingBuffer.h"
+
+class FFGSnapshotBuffer
+{
+public:
+	void SetLimits(float InMinDelay, float InMaxDelay, float InMaxExtrapolationTime);
+	void AddSnapshots(const TArray<FFGPlayerMoveState>& States, float LocalTime, float SendInterval);
+	bool Sample(float LocalTime, float DeltaTime, FFGPlayerMoveState& OutState);
+	bool GetNewest(FFGPlayerMoveState& OutState) const;
+	float GetInterpolationDelay() const { return InterpolationDelay; }
+	float GetJitter() const { return Jitter; }
+private:
+	TFGRingBuffer<FFGPlayerMoveState, 128> Snapshots;
+	FVector ExtrapolationVelocity = FVector::ZeroVector;
+	float TimeOffset = 0.0f;
+	float SnapshotInterval = 0.0f;
+	float Jitter = 0.0f;
+	float InterpolationDelay = 0.1f;
+	float TargetInterpolationDelay = 0.1f;
+	float MinDelay = 0.05f;
+	float MaxDelay = 0.3f;
+	float MaxExtrapolationTime = 0.25f;
+	bool bHasTimeOffset = false;
+};
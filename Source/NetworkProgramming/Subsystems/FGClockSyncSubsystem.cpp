@@ -0,0 +1,108 @@
+#include "FGClockSyncSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "../Player/FGPlayer.h"
+
+const static double SampleSmoothing = 0.1;
+// Samples with a round trip this much slower than the average are mostly queueing delay and barely move the offset.
+const static double SlowSampleFactor = 1.5;
+
+void UFGClockSyncSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	StartTime = FPlatformTime::Seconds();
+}
+
+double UFGClockSyncSubsystem::GetLocalTime() const
+{
+	return FPlatformTime::Seconds() - StartTime;
+}
+
+double UFGClockSyncSubsystem::GetServerTime() const
+{
+	return IsServer() ? GetLocalTime() : GetLocalTime() + LocalStats.Offset;
+}
+
+int32 UFGClockSyncSubsystem::GetLocalTimeMs() const
+{
+	return static_cast<int32>(GetLocalTime() * 1000.0);
+}
+
+int32 UFGClockSyncSubsystem::GetServerTimeMs() const
+{
+	return static_cast<int32>(GetServerTime() * 1000.0);
+}
+
+double UFGClockSyncSubsystem::ServerTimeMsToLocalTime(int32 ServerTimeMs) const
+{
+	const double ServerTime = static_cast<double>(ServerTimeMs) / 1000.0;
+	return IsServer() ? ServerTime : ServerTime - LocalStats.Offset;
+}
+
+void UFGClockSyncSubsystem::OnPongReceived(int32 ClientSendTimeMs, int32 ServerTimeMs)
+{
+	const double Now = GetLocalTime();
+	const double RoundTripTime = FMath::Max(Now - static_cast<double>(ClientSendTimeMs) / 1000.0, 0.0);
+	const double OffsetSample = static_cast<double>(ServerTimeMs) / 1000.0 + RoundTripTime * 0.5 - Now;
+	if (LocalStats.NumberSamples == 0)
+	{
+		LocalStats.Offset = OffsetSample;
+		LocalStats.RoundTripTime = RoundTripTime;
+	}
+	else
+	{
+		const double OffsetSmoothing = RoundTripTime > LocalStats.RoundTripTime * SlowSampleFactor ? SampleSmoothing * 0.1 : SampleSmoothing;
+		LocalStats.Offset += (OffsetSample - LocalStats.Offset) * OffsetSmoothing;
+		LocalStats.Jitter += (FMath::Abs(RoundTripTime - LocalStats.RoundTripTime) - LocalStats.Jitter) * SampleSmoothing;
+		LocalStats.RoundTripTime += (RoundTripTime - LocalStats.RoundTripTime) * SampleSmoothing;
+	}
+	LocalStats.NumberSamples++;
+}
+
+void UFGClockSyncSubsystem::OnPingReceived(const AFGPlayer* Player, float ViewDelay)
+{
+	PlayerStats.FindOrAdd(Player).ViewDelay = static_cast<double>(ViewDelay);
+}
+
+void UFGClockSyncSubsystem::OnPongEchoReceived(const AFGPlayer* Player, int32 ServerTimeMs)
+{
+	const double RoundTripTime = FMath::Max(GetLocalTime() - static_cast<double>(ServerTimeMs) / 1000.0, 0.0);
+	FFGClockSyncStats& Stats = PlayerStats.FindOrAdd(Player);
+	if (Stats.NumberSamples == 0)
+	{
+		Stats.RoundTripTime = RoundTripTime;
+	}
+	else
+	{
+		// A client holding back its echoes should gain as little rewind as a congested link would.
+		const double RoundTripSmoothing = RoundTripTime > Stats.RoundTripTime * SlowSampleFactor ? SampleSmoothing * 0.1 : SampleSmoothing;
+		Stats.Jitter += (FMath::Abs(RoundTripTime - Stats.RoundTripTime) - Stats.Jitter) * SampleSmoothing;
+		Stats.RoundTripTime += (RoundTripTime - Stats.RoundTripTime) * RoundTripSmoothing;
+	}
+	Stats.NumberSamples++;
+}
+
+void UFGClockSyncSubsystem::ReportViewDelay(float InterpolationDelay)
+{
+	LocalStats.ViewDelay += (static_cast<double>(InterpolationDelay) - LocalStats.ViewDelay) * SampleSmoothing;
+}
+
+void UFGClockSyncSubsystem::RemovePlayer(const AFGPlayer* Player)
+{
+	PlayerStats.Remove(Player);
+}
+
+const FFGClockSyncStats* UFGClockSyncSubsystem::GetStats(const AFGPlayer* Player) const
+{
+	if (Player != nullptr && Player->IsLocallyControlled() && !IsServer())
+	{
+		return LocalStats.NumberSamples > 0 ? &LocalStats : nullptr;
+	}
+	return PlayerStats.Find(Player);
+}
+
+bool UFGClockSyncSubsystem::IsServer() const
+{
+	const UWorld* World = GetWorld();
+	return World != nullptr && World->GetNetMode() < NM_Client;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGClockSyncSubsystem.generated.h"
+
+class AFGPlayer;
+
+struct FFGClockSyncStats
+{
+	double Offset = 0.0;
+	double RoundTripTime = 0.0;
+	double Jitter = 0.0;
+	double ViewDelay = 0.0;
+	int32 NumberSamples = 0;
+};
+
+// The server measures round trips from echoed pongs itself, nothing a client claims about its latency is trusted.
+UCLASS()
+class NETWORKPROGRAMMING_API UFGClockSyncSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	double GetLocalTime() const;
+	double GetServerTime() const;
+	int32 GetLocalTimeMs() const;
+	int32 GetServerTimeMs() const;
+	double ServerTimeMsToLocalTime(int32 ServerTimeMs) const;
+	void OnPongReceived(int32 ClientSendTimeMs, int32 ServerTimeMs);
+	void OnPingReceived(const AFGPlayer* Player, float ViewDelay);
+	void OnPongEchoReceived(const AFGPlayer* Player, int32 ServerTimeMs);
+	void ReportViewDelay(float InterpolationDelay);
+	void RemovePlayer(const AFGPlayer* Player);
+	const FFGClockSyncStats* GetStats(const AFGPlayer* Player) const;
+	const FFGClockSyncStats& GetLocalStats() const { return LocalStats; }
+private:
+	bool IsServer() const;
+	TMap<TWeakObjectPtr<const AFGPlayer>, FFGClockSyncStats> PlayerStats;
+	FFGClockSyncStats LocalStats;
+	double StartTime = 0.0;
+};
@@ -0,0 +1,92 @@
+#include "FGEffectPoolSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+
+void UFGEffectPoolSubsystem::Deinitialize()
+{
+	Pools.Reset();
+	AllComponents.Reset();
+	EffectActor = nullptr;
+	Super::Deinitialize();
+}
+
+void UFGEffectPoolSubsystem::PrewarmEffect(UParticleSystem* Effect)
+{
+	if (Effect != nullptr && CanSpawnEffects())
+	{
+		FindOrCreatePool(Effect);
+	}
+}
+
+void UFGEffectPoolSubsystem::SpawnEffect(UParticleSystem* Effect, const FVector& Location, const FRotator& Rotation)
+{
+	if (Effect == nullptr || !CanSpawnEffects() || !IsWithinCullDistance(Location))
+	{
+		return;
+	}
+	FFGEffectPool* Pool = FindOrCreatePool(Effect);
+	if (Pool == nullptr || Pool->Components.Num() == 0)
+	{
+		return;
+	}
+	UParticleSystemComponent* Component = Pool->Components[Pool->NextComponent];
+	Pool->NextComponent = (Pool->NextComponent + 1) % Pool->Components.Num();
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->ActivateSystem(true);
+}
+
+bool UFGEffectPoolSubsystem::CanSpawnEffects() const
+{
+	const UWorld* World = GetWorld();
+	return World != nullptr && World->GetNetMode() != NM_DedicatedServer;
+}
+
+bool UFGEffectPoolSubsystem::IsWithinCullDistance(const FVector& Location) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (PlayerController == nullptr || !PlayerController->IsLocalController())
+	{
+		return true;
+	}
+	FVector ViewLocation = FVector::ZeroVector;
+	FRotator ViewRotation = FRotator::ZeroRotator;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	return FVector::DistSquared(ViewLocation, Location) <= FMath::Square(CullDistance);
+}
+
+FFGEffectPool* UFGEffectPoolSubsystem::FindOrCreatePool(UParticleSystem* Effect)
+{
+	if (FFGEffectPool* Pool = Pools.Find(Effect))
+	{
+		return Pool;
+	}
+	if (EffectActor == nullptr)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags = RF_Transient;
+		EffectActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		if (!ensure(EffectActor != nullptr))
+		{
+			return nullptr;
+		}
+		EffectActor->SetRootComponent(NewObject<USceneComponent>(EffectActor, TEXT("EffectRoot")));
+		EffectActor->GetRootComponent()->RegisterComponent();
+	}
+	FFGEffectPool& Pool = Pools.Add(Effect);
+	for (int32 Index = 0; Index < ComponentsPerEffect; ++Index)
+	{
+		UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(EffectActor);
+		Component->bAutoActivate = false;
+		Component->bAutoDestroy = false;
+		Component->SetUsingAbsoluteLocation(true);
+		Component->SetUsingAbsoluteRotation(true);
+		Component->SetTemplate(Effect);
+		Component->SetupAttachment(EffectActor->GetRootComponent());
+		Component->RegisterComponent();
+		Pool.Components.Add(Component);
+		AllComponents.Add(Component);
+	}
+	return &Pool;
+}
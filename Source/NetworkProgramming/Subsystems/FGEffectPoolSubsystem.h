@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGEffectPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+struct FFGEffectPool
+{
+	TArray<UParticleSystemComponent*> Components;
+	int32 NextComponent = 0;
+};
+
+UCLASS(Config = Game)
+class NETWORKPROGRAMMING_API UFGEffectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+	void PrewarmEffect(UParticleSystem* Effect);
+	void SpawnEffect(UParticleSystem* Effect, const FVector& Location, const FRotator& Rotation);
+private:
+	bool CanSpawnEffects() const;
+	bool IsWithinCullDistance(const FVector& Location) const;
+	FFGEffectPool* FindOrCreatePool(UParticleSystem* Effect);
+	UPROPERTY(Config)
+	int32 ComponentsPerEffect = 8;
+	UPROPERTY(Config)
+	float CullDistance = 20000.0f;
+	UPROPERTY(Transient)
+	AActor* EffectActor = nullptr;
+	UPROPERTY(Transient)
+	TArray<UParticleSystemComponent*> AllComponents;
+	TMap<UParticleSystem*, FFGEffectPool> Pools;
+};
@@ -0,0 +1,92 @@
+#include "FGInterestSubsystem.h"
+#include "../Player/FGPlayer.h"
+
+void UFGInterestSubsystem::RegisterPlayer(AFGPlayer* Player)
+{
+	Players.AddUnique(Player);
+	GridFrame = MAX_uint64;
+}
+
+void UFGInterestSubsystem::UnregisterPlayer(AFGPlayer* Player)
+{
+	Players.RemoveSwap(Player);
+	GridFrame = MAX_uint64;
+}
+
+void UFGInterestSubsystem::GatherViewers(const AFGPlayer* Subject, float NearDistance, float MidDistance, float BehindViewDot, TArray<FFGInterestViewer>& OutViewers)
+{
+	OutViewers.Reset();
+	ViewerIndices.Reset();
+	if (GridFrame != GFrameCounter || GridCellSize != MidDistance)
+	{
+		RebuildGrid(MidDistance);
+	}
+	for (AFGPlayer* Viewer : Players)
+	{
+		if (Viewer != nullptr && Viewer != Subject && !Viewer->IsLocallyControlled() && Viewer->GetNetConnection() != nullptr)
+		{
+			ViewerIndices.Add(Viewer, OutViewers.Num());
+			FFGInterestViewer& InterestViewer = OutViewers.AddDefaulted_GetRef();
+			InterestViewer.Viewer = Viewer;
+		}
+	}
+	const FVector SubjectLocation = Subject->GetActorLocation();
+	const FIntPoint SubjectCell = GetCell(SubjectLocation);
+	for (int32 X = SubjectCell.X - 1; X <= SubjectCell.X + 1; ++X)
+	{
+		for (int32 Y = SubjectCell.Y - 1; Y <= SubjectCell.Y + 1; ++Y)
+		{
+			const TArray<AFGPlayer*, TInlineAllocator<4>>* Cell = Grid.Find(FIntPoint(X, Y));
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+			for (AFGPlayer* Viewer : *Cell)
+			{
+				const float DistanceSquared = FVector::DistSquared(Viewer->GetActorLocation(), SubjectLocation);
+				if (DistanceSquared > FMath::Square(MidDistance))
+				{
+					continue;
+				}
+				if (const int32* ViewerIndex = ViewerIndices.Find(Viewer))
+				{
+					OutViewers[*ViewerIndex].Tier = GetViewTier(Viewer, SubjectLocation, DistanceSquared, NearDistance, MidDistance, BehindViewDot);
+				}
+			}
+		}
+	}
+}
+
+void UFGInterestSubsystem::RebuildGrid(float CellSize)
+{
+	GridFrame = GFrameCounter;
+	GridCellSize = FMath::Max(CellSize, 1.0f);
+	for (auto& Cell : Grid)
+	{
+		Cell.Value.Reset();
+	}
+	for (AFGPlayer* Player : Players)
+	{
+		if (Player != nullptr)
+		{
+			Grid.FindOrAdd(GetCell(Player->GetActorLocation())).Add(Player);
+		}
+	}
+}
+
+FIntPoint UFGInterestSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / GridCellSize), FMath::FloorToInt(Location.Y / GridCellSize));
+}
+
+EFGInterestTier UFGInterestSubsystem::GetViewTier(const AFGPlayer* Viewer, const FVector& SubjectLocation, float DistanceSquared, float NearDistance, float MidDistance, float BehindViewDot) const
+{
+	EFGInterestTier Tier = DistanceSquared <= FMath::Square(NearDistance) ? EFGInterestTier::Near : EFGInterestTier::Mid;
+	const FVector ViewDirection = Viewer->GetViewDirection().GetSafeNormal2D();
+	const FVector ToSubject = (SubjectLocation - Viewer->GetActorLocation()).GetSafeNormal2D();
+	if (!ViewDirection.IsNearlyZero() && DistanceSquared > FMath::Square(NearDistance * 0.5f) && FVector::DotProduct(ViewDirection, ToSubject) < BehindViewDot)
+	{
+		Tier = Tier == EFGInterestTier::Near ? EFGInterestTier::Mid : EFGInterestTier::Far;
+	}
+	return Tier;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGInterestSubsystem.generated.h"
+
+class AFGPlayer;
+
+UENUM()
+enum class EFGInterestTier : uint8
+{
+	Near,
+	Mid,
+	Far
+};
+
+struct FFGInterestViewer
+{
+	AFGPlayer* Viewer = nullptr;
+	EFGInterestTier Tier = EFGInterestTier::Far;
+};
+
+UCLASS()
+class NETWORKPROGRAMMING_API UFGInterestSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	void RegisterPlayer(AFGPlayer* Player);
+	void UnregisterPlayer(AFGPlayer* Player);
+	const TArray<AFGPlayer*>& GetPlayers() const { return Players; }
+	void GatherViewers(const AFGPlayer* Subject, float NearDistance, float MidDistance, float BehindViewDot, TArray<FFGInterestViewer>& OutViewers);
+private:
+	void RebuildGrid(float CellSize);
+	FIntPoint GetCell(const FVector& Location) const;
+	EFGInterestTier GetViewTier(const AFGPlayer* Viewer, const FVector& SubjectLocation, float DistanceSquared, float NearDistance, float MidDistance, float BehindViewDot) const;
+	UPROPERTY(Transient)
+	TArray<AFGPlayer*> Players;
+	TMap<FIntPoint, TArray<AFGPlayer*, TInlineAllocator<4>>> Grid;
+	TMap<const AFGPlayer*, int32> ViewerIndices;
+	uint64 GridFrame = MAX_uint64;
+	float GridCellSize = 1.0f;
+};
@@ -0,0 +1,148 @@
+#include "FGLagCompensationSubsystem.h"
+#include "FGClockSyncSubsystem.h"
+#include "Engine/World.h"
+#include "../Player/FGPlayer.h"
+
+const static double MaxRewindTime = 1.0;
+const static double SampleInterval = 1.0 / 60.0;
+
+void UFGLagCompensationSubsystem::RegisterPlayer(AFGPlayer* Player)
+{
+	if (!Histories.ContainsByPredicate([Player](const FFGPositionHistory& History) { return History.Player == Player; }))
+	{
+		Histories.AddDefaulted_GetRef().Player = Player;
+	}
+}
+
+void UFGLagCompensationSubsystem::UnregisterPlayer(AFGPlayer* Player)
+{
+	Histories.RemoveAllSwap([Player](const FFGPositionHistory& History) { return History.Player == Player; });
+}
+
+void UFGLagCompensationSubsystem::RecordPosition(AFGPlayer* Player, double Time, const FVector& Location, float CollisionRadius)
+{
+	for (FFGPositionHistory& History : Histories)
+	{
+		if (History.Player != Player)
+		{
+			continue;
+		}
+		const int32 NumberSamples = History.Samples.Num();
+		if (NumberSamples > 0 && History.Samples.Last().Time >= Time)
+		{
+			return;
+		}
+		const bool bReplaceNewest = NumberSamples >= 2 && Time - History.Samples[NumberSamples - 2].Time < SampleInterval;
+		FFGPositionSample& Sample = bReplaceNewest ? History.Samples.Last() : History.Samples.Add(FFGPositionSample());
+		Sample.Time = Time;
+		Sample.Location = Location;
+		History.CollisionRadius = CollisionRadius;
+		UpdateBounds(History, Location);
+		return;
+	}
+}
+
+bool UFGLagCompensationSubsystem::RewindTrace(const FVector& Start, const FVector& End, double ViewTime, const AActor* IgnoredActor, AFGPlayer*& OutHitPlayer, FVector& OutHitLocation) const
+{
+	OutHitPlayer = nullptr;
+	const FVector Segment = End - Start;
+	const float SegmentLength = Segment.Size();
+	if (SegmentLength <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+	const FVector Direction = Segment / SegmentLength;
+	float ClosestHitDistance = SegmentLength;
+	for (const FFGPositionHistory& History : Histories)
+	{
+		if (History.Player == IgnoredActor || History.Samples.IsEmpty())
+		{
+			continue;
+		}
+		const FVector ClosestPoint = FMath::ClosestPointOnSegment(History.BoundsCenter, Start, End);
+		if (FVector::DistSquared(ClosestPoint, History.BoundsCenter) > FMath::Square(History.BoundsRadius + History.CollisionRadius))
+		{
+			continue;
+		}
+		const FVector RewoundLocation = GetRewoundLocation(History, ViewTime);
+		const FVector ToCenter = RewoundLocation - Start;
+		const float Projection = FVector::DotProduct(ToCenter, Direction);
+		const float DistanceSquared = ToCenter.SizeSquared() - FMath::Square(Projection);
+		const float RadiusSquared = FMath::Square(History.CollisionRadius);
+		if (DistanceSquared > RadiusSquared)
+		{
+			continue;
+		}
+		const float HalfChord = FMath::Sqrt(RadiusSquared - DistanceSquared);
+		const float HitDistance = FMath::Max(Projection - HalfChord, 0.0f);
+		if (Projection + HalfChord < 0.0f || HitDistance > ClosestHitDistance)
+		{
+			continue;
+		}
+		ClosestHitDistance = HitDistance;
+		OutHitPlayer = History.Player;
+		OutHitLocation = Start + Direction * HitDistance;
+	}
+	return OutHitPlayer != nullptr;
+}
+
+double UFGLagCompensationSubsystem::GetViewTime(const AFGPlayer* Shooter) const
+{
+	const UFGClockSyncSubsystem* ClockSyncSubsystem = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+	if (ClockSyncSubsystem == nullptr)
+	{
+		return 0.0;
+	}
+	const double Now = ClockSyncSubsystem->GetServerTime();
+	const FFGClockSyncStats* Stats = ClockSyncSubsystem->GetStats(Shooter);
+	if (Stats == nullptr || Shooter->IsLocallyControlled())
+	{
+		return Now;
+	}
+	const double Latency = Stats->RoundTripTime * 0.5 + Stats->ViewDelay;
+	return Now - FMath::Min(Latency, MaxRewindTime);
+}
+
+FVector UFGLagCompensationSubsystem::GetRewoundLocation(const FFGPositionHistory& History, double ViewTime)
+{
+	const int32 NumberSamples = History.Samples.Num();
+	if (ViewTime >= History.Samples.Last().Time)
+	{
+		return History.Samples.Last().Location;
+	}
+	for (int32 Index = NumberSamples - 1; Index > 0; --Index)
+	{
+		const FFGPositionSample& From = History.Samples[Index - 1];
+		if (From.Time <= ViewTime)
+		{
+			const FFGPositionSample& To = History.Samples[Index];
+			const float Alpha = static_cast<float>((ViewTime - From.Time) / (To.Time - From.Time));
+			return FMath::Lerp(From.Location, To.Location, Alpha);
+		}
+	}
+	return History.Samples.First().Location;
+}
+
+void UFGLagCompensationSubsystem::UpdateBounds(FFGPositionHistory& History, const FVector& Location)
+{
+	// Only ever grown, positions dropping out of the history leave it too large until the periodic rebuild.
+	if (History.Samples.Num() > 1 && ++History.NumberUpdatesSinceRebuild < History.Samples.Max())
+	{
+		const float Distance = FVector::Dist(Location, History.BoundsCenter);
+		if (Distance > History.BoundsRadius)
+		{
+			const float NewRadius = (History.BoundsRadius + Distance) * 0.5f;
+			History.BoundsCenter += (Location - History.BoundsCenter) * ((NewRadius - History.BoundsRadius) / Distance);
+			History.BoundsRadius = NewRadius;
+		}
+		return;
+	}
+	History.NumberUpdatesSinceRebuild = 0;
+	History.BoundsCenter = Location;
+	float MaxDistanceSquared = 0.0f;
+	for (int32 Index = 0; Index < History.Samples.Num(); ++Index)
+	{
+		MaxDistanceSquared = FMath::Max(MaxDistanceSquared, FVector::DistSquared(History.Samples[Index].Location, History.BoundsCenter));
+	}
+	History.BoundsRadius = FMath::Sqrt(MaxDistanceSquared);
+}
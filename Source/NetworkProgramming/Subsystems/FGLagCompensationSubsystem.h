@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "../FGRingBuffer.h"
+#include "FGLagCompensationSubsystem.generated.h"
+
+class AFGPlayer;
+
+struct FFGPositionSample
+{
+	double Time = 0.0;
+	FVector Location = FVector::ZeroVector;
+};
+
+struct FFGPositionHistory
+{
+	AFGPlayer* Player = nullptr;
+	// Spaced at least SampleInterval apart, only the newest one follows the player every tick.
+	TFGRingBuffer<FFGPositionSample, 128> Samples;
+	FVector BoundsCenter = FVector::ZeroVector;
+	float BoundsRadius = 0.0f;
+	float CollisionRadius = 0.0f;
+	int32 NumberUpdatesSinceRebuild = 0;
+};
+
+UCLASS()
+class NETWORKPROGRAMMING_API UFGLagCompensationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	void RegisterPlayer(AFGPlayer* Player);
+	void UnregisterPlayer(AFGPlayer* Player);
+	void RecordPosition(AFGPlayer* Player, double Time, const FVector& Location, float CollisionRadius);
+	bool RewindTrace(const FVector& Start, const FVector& End, double ViewTime, const AActor* IgnoredActor, AFGPlayer*& OutHitPlayer, FVector& OutHitLocation) const;
+	double GetViewTime(const AFGPlayer* Shooter) const;
+private:
+	static FVector GetRewoundLocation(const FFGPositionHistory& History, double ViewTime);
+	static void UpdateBounds(FFGPositionHistory& History, const FVector& Location);
+	TArray<FFGPositionHistory> Histories;
+};
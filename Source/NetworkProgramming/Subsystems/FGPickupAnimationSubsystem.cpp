@@ -0,0 +1,167 @@
+#include "FGPickupAnimationSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "../FGPickup.h"
+
+const static float BobHeight = 30.0f;
+const static float BobFrequency = 0.65f;
+const static float SpinSpeed = 20.0f;
+
+void UFGPickupAnimationSubsystem::Deinitialize()
+{
+	Groups.Reset();
+	InstancedMeshes.Reset();
+	InstanceActor = nullptr;
+	NumberPickups = 0;
+	Super::Deinitialize();
+}
+
+void UFGPickupAnimationSubsystem::Tick(float DeltaTime)
+{
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+	const FVector Bob(0.0f, 0.0f, FMath::MakePulsatingValue(TimeSeconds, BobFrequency) * BobHeight);
+	const FQuat Spin(FVector::UpVector, FMath::DegreesToRadians(FMath::Fmod(TimeSeconds * SpinSpeed, 360.0f)));
+	for (FFGPickupInstanceGroup& Group : Groups)
+	{
+		const int32 NumberInstances = Group.Pickups.Num();
+		if (NumberInstances == 0)
+		{
+			continue;
+		}
+		for (int32 Index = 0; Index < NumberInstances; ++Index)
+		{
+			const FTransform& BaseTransform = Group.BaseTransforms[Index];
+			const FVector Scale = Group.Visible[Index] ? BaseTransform.GetScale3D() : FVector::ZeroVector;
+			Group.InstanceTransforms[Index] = FTransform(Spin * BaseTransform.GetRotation(), BaseTransform.GetLocation() + Bob, Scale);
+		}
+		Group.InstancedMesh->BatchUpdateInstancesTransforms(0, Group.InstanceTransforms, true, true, true);
+	}
+}
+
+bool UFGPickupAnimationSubsystem::IsTickable() const
+{
+	return NumberPickups > 0 && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UFGPickupAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGPickupAnimationSubsystem, STATGROUP_Tickables);
+}
+
+bool UFGPickupAnimationSubsystem::RegisterPickup(AFGPickup* Pickup)
+{
+	UWorld* World = GetWorld();
+	UStaticMeshComponent* PickupMesh = Pickup != nullptr ? Pickup->MeshComponent : nullptr;
+	if (World == nullptr || World->GetNetMode() == NM_DedicatedServer || PickupMesh == nullptr || PickupMesh->GetStaticMesh() == nullptr)
+	{
+		return false;
+	}
+	int32 GroupIndex = INDEX_NONE;
+	int32 InstanceIndex = INDEX_NONE;
+	if (FindPickup(Pickup, GroupIndex, InstanceIndex))
+	{
+		return true;
+	}
+	TArray<UMaterialInterface*> Materials;
+	for (int32 MaterialIndex = 0; MaterialIndex < PickupMesh->GetNumMaterials(); ++MaterialIndex)
+	{
+		Materials.Add(PickupMesh->GetMaterial(MaterialIndex));
+	}
+	GroupIndex = FindOrCreateGroup(PickupMesh->GetStaticMesh(), Materials);
+	if (GroupIndex == INDEX_NONE)
+	{
+		return false;
+	}
+	FFGPickupInstanceGroup& Group = Groups[GroupIndex];
+	const FTransform BaseTransform = PickupMesh->GetComponentTransform();
+	Group.Pickups.Add(Pickup);
+	Group.BaseTransforms.Add(BaseTransform);
+	Group.Visible.Add(true);
+	Group.InstanceTransforms.Add(BaseTransform);
+	Group.InstancedMesh->AddInstance(BaseTransform);
+	NumberPickups++;
+	return true;
+}
+
+void UFGPickupAnimationSubsystem::UnregisterPickup(AFGPickup* Pickup)
+{
+	int32 GroupIndex = INDEX_NONE;
+	int32 InstanceIndex = INDEX_NONE;
+	if (!FindPickup(Pickup, GroupIndex, InstanceIndex))
+	{
+		return;
+	}
+	FFGPickupInstanceGroup& Group = Groups[GroupIndex];
+	Group.Pickups.RemoveAt(InstanceIndex);
+	Group.BaseTransforms.RemoveAt(InstanceIndex);
+	Group.Visible.RemoveAt(InstanceIndex);
+	Group.InstanceTransforms.RemoveAt(InstanceIndex);
+	// Removing an instance shifts the ones after it, same as the arrays above.
+	Group.InstancedMesh->RemoveInstance(InstanceIndex);
+	NumberPickups--;
+}
+
+void UFGPickupAnimationSubsystem::SetPickupVisible(AFGPickup* Pickup, bool bVisible)
+{
+	int32 GroupIndex = INDEX_NONE;
+	int32 InstanceIndex = INDEX_NONE;
+	if (FindPickup(Pickup, GroupIndex, InstanceIndex))
+	{
+		Groups[GroupIndex].Visible[InstanceIndex] = bVisible;
+	}
+}
+
+bool UFGPickupAnimationSubsystem::FindPickup(const AFGPickup* Pickup, int32& OutGroupIndex, int32& OutInstanceIndex) const
+{
+	for (int32 GroupIndex = 0; GroupIndex < Groups.Num(); ++GroupIndex)
+	{
+		const int32 InstanceIndex = Groups[GroupIndex].Pickups.IndexOfByKey(Pickup);
+		if (InstanceIndex != INDEX_NONE)
+		{
+			OutGroupIndex = GroupIndex;
+			OutInstanceIndex = InstanceIndex;
+			return true;
+		}
+	}
+	return false;
+}
+
+int32 UFGPickupAnimationSubsystem::FindOrCreateGroup(UStaticMesh* Mesh, const TArray<UMaterialInterface*>& Materials)
+{
+	const int32 FoundGroupIndex = Groups.IndexOfByPredicate([Mesh, &Materials](const FFGPickupInstanceGroup& Group)
+	{
+		return Group.Mesh == Mesh && Group.Materials == Materials;
+	});
+	if (FoundGroupIndex != INDEX_NONE)
+	{
+		return FoundGroupIndex;
+	}
+	if (InstanceActor == nullptr)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags = RF_Transient;
+		InstanceActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+		if (!ensure(InstanceActor != nullptr))
+		{
+			return INDEX_NONE;
+		}
+		InstanceActor->SetRootComponent(NewObject<USceneComponent>(InstanceActor, TEXT("PickupRoot")));
+		InstanceActor->GetRootComponent()->RegisterComponent();
+	}
+	UInstancedStaticMeshComponent* InstancedMesh = NewObject<UInstancedStaticMeshComponent>(InstanceActor);
+	InstancedMesh->SetStaticMesh(Mesh);
+	for (int32 MaterialIndex = 0; MaterialIndex < Materials.Num(); ++MaterialIndex)
+	{
+		InstancedMesh->SetMaterial(MaterialIndex, Materials[MaterialIndex]);
+	}
+	InstancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	InstancedMesh->SetGenerateOverlapEvents(false);
+	InstancedMesh->SetupAttachment(InstanceActor->GetRootComponent());
+	InstancedMesh->RegisterComponent();
+	InstancedMeshes.Add(InstancedMesh);
+	const int32 GroupIndex = Groups.AddDefaulted();
+	Groups[GroupIndex].Mesh = Mesh;
+	Groups[GroupIndex].Materials = Materials;
+	Groups[GroupIndex].InstancedMesh = InstancedMesh;
+	return GroupIndex;
+}
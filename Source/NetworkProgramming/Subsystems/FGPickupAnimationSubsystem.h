@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGPickupAnimationSubsystem.generated.h"
+
+class AFGPickup;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+struct FFGPickupInstanceGroup
+{
+	UStaticMesh* Mesh = nullptr;
+	TArray<UMaterialInterface*> Materials;
+	UInstancedStaticMeshComponent* InstancedMesh = nullptr;
+	TArray<AFGPickup*> Pickups;
+	TArray<FTransform> BaseTransforms;
+	TArray<bool> Visible;
+	TArray<FTransform> InstanceTransforms;
+};
+
+UCLASS()
+class NETWORKPROGRAMMING_API UFGPickupAnimationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	bool RegisterPickup(AFGPickup* Pickup);
+	void UnregisterPickup(AFGPickup* Pickup);
+	void SetPickupVisible(AFGPickup* Pickup, bool bVisible);
+private:
+	bool FindPickup(const AFGPickup* Pickup, int32& OutGroupIndex, int32& OutInstanceIndex) const;
+	int32 FindOrCreateGroup(UStaticMesh* Mesh, const TArray<UMaterialInterface*>& Materials);
+	UPROPERTY(Transient)
+	TArray<UInstancedStaticMeshComponent*> InstancedMeshes;
+	UPROPERTY(Transient)
+	AActor* InstanceActor = nullptr;
+	TArray<FFGPickupInstanceGroup> Groups;
+	int32 NumberPickups = 0;
+};
@@ -0,0 +1,58 @@
+#include "FGPickupGridSubsystem.h"
+#include "../FGPickup.h"
+
+void UFGPickupGridSubsystem::RegisterPickup(AFGPickup* Pickup, float Radius)
+{
+	FFGPickupGridEntry Entry;
+	Entry.Pickup = Pickup;
+	Entry.Location = Pickup->GetActorLocation();
+	Entry.Radius = Radius;
+	Grid.FindOrAdd(GetCell(Entry.Location)).Add(Entry);
+	MaxPickupRadius = FMath::Max(MaxPickupRadius, Radius);
+}
+
+void UFGPickupGridSubsystem::UnregisterPickup(AFGPickup* Pickup)
+{
+	auto* Cell = Grid.Find(GetCell(Pickup->GetActorLocation()));
+	if (Cell == nullptr)
+	{
+		return;
+	}
+	const int32 EntryIndex = Cell->IndexOfByPredicate([Pickup](const FFGPickupGridEntry& Entry) { return Entry.Pickup == Pickup; });
+	if (EntryIndex != INDEX_NONE)
+	{
+		Cell->RemoveAtSwap(EntryIndex, 1, false);
+	}
+}
+
+void UFGPickupGridSubsystem::GatherPickups(const FVector& Location, float Radius, TArray<AFGPickup*>& OutPickups) const
+{
+	OutPickups.Reset();
+	const FVector Reach(Radius + MaxPickupRadius);
+	const FIntPoint MinCell = GetCell(Location - Reach);
+	const FIntPoint MaxCell = GetCell(Location + Reach);
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const auto* Cell = Grid.Find(FIntPoint(X, Y));
+			if (Cell == nullptr)
+			{
+				continue;
+			}
+			for (const FFGPickupGridEntry& Entry : *Cell)
+			{
+				if (FVector::DistSquared(Entry.Location, Location) <= FMath::Square(Entry.Radius + Radius))
+				{
+					OutPickups.Add(Entry.Pickup);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UFGPickupGridSubsystem::GetCell(const FVector& Location) const
+{
+	const float Size = GetCellSize();
+	return FIntPoint(FMath::FloorToInt(Location.X / Size), FMath::FloorToInt(Location.Y / Size));
+}
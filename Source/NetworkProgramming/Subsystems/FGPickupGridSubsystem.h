@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGPickupGridSubsystem.generated.h"
+
+class AFGPickup;
+
+struct FFGPickupGridEntry
+{
+	AFGPickup* Pickup = nullptr;
+	FVector Location = FVector::ZeroVector;
+	float Radius = 0.0f;
+};
+
+UCLASS(Config = Game)
+class NETWORKPROGRAMMING_API UFGPickupGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	void RegisterPickup(AFGPickup* Pickup, float Radius);
+	void UnregisterPickup(AFGPickup* Pickup);
+	void GatherPickups(const FVector& Location, float Radius, TArray<AFGPickup*>& OutPickups) const;
+	float GetCellSize() const { return FMath::Max(CellSize, 1.0f); }
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	UPROPERTY(Config)
+	float CellSize = 1000.0f;
+	TMap<FIntPoint, TArray<FFGPickupGridEntry, TInlineAllocator<4>>> Grid;
+	float MaxPickupRadius = 0.0f;
+};
@@ -0,0 +1,282 @@
+#include "FGProjectileSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "../FGRocket.h"
+#include "../Player/FGPlayer.h"
+
+void UFGProjectileSubsystem::Deinitialize()
+{
+	Rockets.Reset();
+	PendingTraces.Reset();
+	InstancedMesh = nullptr;
+	Super::Deinitialize();
+}
+
+void UFGProjectileSubsystem::Tick(float DeltaTime)
+{
+	ResolvePendingTraces();
+	const int32 NumberProjectiles = Rockets.Num();
+	for (int32 Index = 0; Index < NumberProjectiles; ++Index)
+	{
+		LifeTimes[Index] -= DeltaTime;
+		Distances[Index] += Velocities[Index] * DeltaTime;
+	}
+	const float CorrectionAlpha = 0.9f * DeltaTime;
+	for (int32 Index = 0; Index < NumberProjectiles; ++Index)
+	{
+		if (!Rotations[Index].Equals(Corrections[Index]))
+		{
+			Rotations[Index] = FQuat::Slerp(Rotations[Index], Corrections[Index], CorrectionAlpha);
+		}
+	}
+	for (int32 Index = 0; Index < NumberProjectiles; ++Index)
+	{
+		PreviousLocations[Index] = Locations[Index];
+		Locations[Index] = StartLocations[Index] + Rotations[Index].GetForwardVector() * Distances[Index];
+	}
+	for (int32 Index = 0; Index < NumberProjectiles; ++Index)
+	{
+		AFGRocket* Rocket = Rockets[Index];
+		const FVector Direction = Rotations[Index].GetForwardVector();
+#if !UE_BUILD_SHIPPING
+		if (Rocket->bDebugDrawCorrection)
+		{
+			const float ArrowLength = 3000.0f;
+			const float ArrowSize = 50.0f;
+			DrawDebugDirectionalArrow(GetWorld(), StartLocations[Index], StartLocations[Index] + OriginalDirections[Index] * ArrowLength, ArrowSize, FColor::Red);
+			DrawDebugDirectionalArrow(GetWorld(), StartLocations[Index], StartLocations[Index] + Direction * ArrowLength, ArrowSize, FColor::Green);
+		}
+#endif // !UE_BUILD_SHIPPING
+		const FVector TraceStart = PreviousLocations[Index];
+		const FVector TraceEnd = Locations[Index] + Direction * CollisionLookahead;
+		AFGPlayer* HitPlayer = nullptr;
+		bool bDetonate = LifeTimes[Index] < 0.0f;
+		if (!bDetonate && bAsyncCollision)
+		{
+			bDetonate = Rocket->TraceRewound(TraceStart, TraceEnd, HitPlayer);
+			if (!bDetonate)
+			{
+				FFGPendingRocketTrace& PendingTrace = PendingTraces.AddDefaulted_GetRef();
+				PendingTrace.Handle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, TraceStart, TraceEnd, ECC_Visibility, Rocket->GetCollisionQueryParams());
+				PendingTrace.Rocket = Rocket;
+				PendingTrace.FlightId = Rocket->FlightId;
+			}
+		}
+		else if (!bDetonate)
+		{
+			bDetonate = Rocket->TraceFlight(TraceStart, TraceEnd, HitPlayer);
+		}
+		if (bDetonate)
+		{
+			Detonations.Add(TPair<AFGRocket*, AFGPlayer*>(Rocket, HitPlayer));
+		}
+	}
+	// Exploding removes the rocket from the arrays, so wait until the loop is done.
+	FlushDetonations();
+	UpdateInstances();
+}
+
+bool UFGProjectileSubsystem::IsTickable() const
+{
+	return (Rockets.Num() > 0 || PendingTraces.Num() > 0) && !HasAnyFlags(RF_ClassDefaultObject);
+}
+
+TStatId UFGProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void UFGProjectileSubsystem::AddProjectile(AFGRocket* Rocket, const FVector& StartLocation, const FVector& Direction, float Velocity, float LifeTime, float ElapsedTime)
+{
+	if (!ensure(Rocket != nullptr))
+	{
+		return;
+	}
+	if (!bTriedCreatingInstancedMesh)
+	{
+		CreateInstancedMesh(Rocket);
+	}
+	if (!IsValidProjectile(Rocket))
+	{
+		Rocket->ProjectileIndex = Rockets.Add(Rocket);
+		StartLocations.AddUninitialized();
+		Rotations.AddUninitialized();
+		Corrections.AddUninitialized();
+		Locations.AddUninitialized();
+		PreviousLocations.AddUninitialized();
+		Distances.AddUninitialized();
+		Velocities.AddUninitialized();
+		LifeTimes.AddUninitialized();
+#if !UE_BUILD_SHIPPING
+		OriginalDirections.AddUninitialized();
+#endif // !UE_BUILD_SHIPPING
+	}
+	const int32 Index = Rocket->ProjectileIndex;
+	Rocket->FlightId++;
+	StartLocations[Index] = StartLocation;
+	Rotations[Index] = Direction.ToOrientationQuat();
+	Corrections[Index] = Rotations[Index];
+	Distances[Index] = Velocity * ElapsedTime;
+	Locations[Index] = StartLocation + Direction * Distances[Index];
+	PreviousLocations[Index] = StartLocation;
+	Velocities[Index] = Velocity;
+	LifeTimes[Index] = LifeTime - ElapsedTime;
+#if !UE_BUILD_SHIPPING
+	OriginalDirections[Index] = Direction;
+#endif // !UE_BUILD_SHIPPING
+	if (InstancedMesh != nullptr && InstancedMesh->GetInstanceCount() < Rockets.Num())
+	{
+		InstancedMesh->AddInstance(MeshTransform * FTransform(Rotations[Index], Locations[Index]));
+	}
+}
+
+void UFGProjectileSubsystem::RemoveProjectile(AFGRocket* Rocket)
+{
+	if (!IsValidProjectile(Rocket))
+	{
+		return;
+	}
+	const int32 Index = Rocket->ProjectileIndex;
+	Rocket->ProjectileIndex = INDEX_NONE;
+	Rockets.RemoveAtSwap(Index, 1, false);
+	StartLocations.RemoveAtSwap(Index, 1, false);
+	Rotations.RemoveAtSwap(Index, 1, false);
+	Corrections.RemoveAtSwap(Index, 1, false);
+	Locations.RemoveAtSwap(Index, 1, false);
+	PreviousLocations.RemoveAtSwap(Index, 1, false);
+	Distances.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	LifeTimes.RemoveAtSwap(Index, 1, false);
+#if !UE_BUILD_SHIPPING
+	OriginalDirections.RemoveAtSwap(Index, 1, false);
+#endif // !UE_BUILD_SHIPPING
+	if (Rockets.IsValidIndex(Index))
+	{
+		Rockets[Index]->ProjectileIndex = Index;
+	}
+	if (InstancedMesh != nullptr && InstancedMesh->GetInstanceCount() > Rockets.Num())
+	{
+		InstancedMesh->RemoveInstance(InstancedMesh->GetInstanceCount() - 1);
+	}
+}
+
+void UFGProjectileSubsystem::SetCorrection(const AFGRocket* Rocket, const FVector& Direction)
+{
+	if (IsValidProjectile(Rocket))
+	{
+		Corrections[Rocket->ProjectileIndex] = Direction.ToOrientationQuat();
+	}
+}
+
+FVector UFGProjectileSubsystem::GetLocation(const AFGRocket* Rocket) const
+{
+	return IsValidProjectile(Rocket) ? Locations[Rocket->ProjectileIndex] : Rocket->GetActorLocation();
+}
+
+FVector UFGProjectileSubsystem::GetDirection(const AFGRocket* Rocket) const
+{
+	return IsValidProjectile(Rocket) ? Rotations[Rocket->ProjectileIndex].GetForwardVector() : Rocket->GetActorForwardVector();
+}
+
+bool UFGProjectileSubsystem::IsValidProjectile(const AFGRocket* Rocket) const
+{
+	return Rocket != nullptr && Rockets.IsValidIndex(Rocket->ProjectileIndex) && Rockets[Rocket->ProjectileIndex] == Rocket;
+}
+
+void UFGProjectileSubsystem::CreateInstancedMesh(const AFGRocket* Rocket)
+{
+	bTriedCreatingInstancedMesh = true;
+	UWorld* World = GetWorld();
+	const UStaticMeshComponent* RocketMesh = Rocket->MeshComponent;
+	if (World == nullptr || World->GetNetMode() == NM_DedicatedServer || RocketMesh == nullptr || RocketMesh->GetStaticMesh() == nullptr)
+	{
+		return;
+	}
+	FActorSpawnParameters SpawnParameters;
+	SpawnParameters.ObjectFlags = RF_Transient;
+	AActor* MeshActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParameters);
+	if (!ensure(MeshActor != nullptr))
+	{
+		return;
+	}
+	InstancedMesh = NewObject<UInstancedStaticMeshComponent>(MeshActor, TEXT("RocketInstances"));
+	InstancedMesh->SetStaticMesh(RocketMesh->GetStaticMesh());
+	for (int32 MaterialIndex = 0; MaterialIndex < RocketMesh->GetNumMaterials(); ++MaterialIndex)
+	{
+		InstancedMesh->SetMaterial(MaterialIndex, RocketMesh->GetMaterial(MaterialIndex));
+	}
+	InstancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	InstancedMesh->SetGenerateOverlapEvents(false);
+	MeshActor->SetRootComponent(InstancedMesh);
+	InstancedMesh->RegisterComponent();
+	MeshTransform = RocketMesh->GetRelativeTransform();
+}
+
+void UFGProjectileSubsystem::ResolvePendingTraces()
+{
+	if (PendingTraces.Num() == 0)
+	{
+		return;
+	}
+	FTraceDatum TraceDatum;
+	for (const FFGPendingRocketTrace& PendingTrace : PendingTraces)
+	{
+		AFGRocket* Rocket = PendingTrace.Rocket.Get();
+		// The rocket may have exploded or been fired again since the trace went out.
+		if (Rocket == nullptr || Rocket->FlightId != PendingTrace.FlightId || !IsValidProjectile(Rocket))
+		{
+			continue;
+		}
+		if (!GetWorld()->QueryTraceData(PendingTrace.Handle, TraceDatum) || TraceDatum.OutHits.Num() == 0)
+		{
+			continue;
+		}
+		AFGPlayer* HitPlayer = nullptr;
+		if (Rocket->ShouldExplodeOnHit(TraceDatum.OutHits[0], HitPlayer))
+		{
+			Detonations.Add(TPair<AFGRocket*, AFGPlayer*>(Rocket, HitPlayer));
+		}
+	}
+	PendingTraces.Reset();
+	FlushDetonations();
+}
+
+void UFGProjectileSubsystem::FlushDetonations()
+{
+	for (const TPair<AFGRocket*, AFGPlayer*>& Detonation : Detonations)
+	{
+		if (Detonation.Value != nullptr)
+		{
+			Detonation.Value->OnHit(Detonation.Key);
+		}
+		Detonation.Key->Explode();
+	}
+	Detonations.Reset();
+}
+
+void UFGProjectileSubsystem::UpdateInstances()
+{
+	if (InstancedMesh == nullptr)
+	{
+		return;
+	}
+	const int32 NumberProjectiles = Rockets.Num();
+	InstanceTransforms.SetNum(NumberProjectiles, false);
+	for (int32 Index = 0; Index < NumberProjectiles; ++Index)
+	{
+		InstanceTransforms[Index] = MeshTransform * FTransform(Rotations[Index], Locations[Index]);
+	}
+	while (InstancedMesh->GetInstanceCount() > NumberProjectiles)
+	{
+		InstancedMesh->RemoveInstance(InstancedMesh->GetInstanceCount() - 1);
+	}
+	while (InstancedMesh->GetInstanceCount() < NumberProjectiles)
+	{
+		InstancedMesh->AddInstance(InstanceTransforms[InstancedMesh->GetInstanceCount()]);
+	}
+	if (NumberProjectiles > 0)
+	{
+		InstancedMesh->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+	}
+}
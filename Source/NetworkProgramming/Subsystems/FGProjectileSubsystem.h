@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+#include "FGProjectileSubsystem.generated.h"
+
+class AFGRocket;
+class AFGPlayer;
+class UInstancedStaticMeshComponent;
+
+struct FFGPendingRocketTrace
+{
+	FTraceHandle Handle;
+	TWeakObjectPtr<AFGRocket> Rocket;
+	uint32 FlightId = 0;
+};
+
+UCLASS(Config = Game)
+class NETWORKPROGRAMMING_API UFGProjectileSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+	void AddProjectile(AFGRocket* Rocket, const FVector& StartLocation, const FVector& Direction, float Velocity, float LifeTime, float ElapsedTime);
+	void RemoveProjectile(AFGRocket* Rocket);
+	void SetCorrection(const AFGRocket* Rocket, const FVector& Direction);
+	FVector GetLocation(const AFGRocket* Rocket) const;
+	FVector GetDirection(const AFGRocket* Rocket) const;
+	int32 GetNumberProjectiles() const { return Rockets.Num(); }
+private:
+	bool IsValidProjectile(const AFGRocket* Rocket) const;
+	void CreateInstancedMesh(const AFGRocket* Rocket);
+	void ResolvePendingTraces();
+	void FlushDetonations();
+	void UpdateInstances();
+	UPROPERTY(Config)
+	bool bAsyncCollision = true;
+	UPROPERTY(Config)
+	float CollisionLookahead = 100.0f;
+	UPROPERTY(Transient)
+	TArray<AFGRocket*> Rockets;
+	TArray<FVector> StartLocations;
+	TArray<FQuat> Rotations;
+	TArray<FQuat> Corrections;
+	TArray<FVector> Locations;
+	TArray<FVector> PreviousLocations;
+	TArray<float> Distances;
+	TArray<float> Velocities;
+	TArray<float> LifeTimes;
+#if !UE_BUILD_SHIPPING
+	TArray<FVector> OriginalDirections;
+#endif // !UE_BUILD_SHIPPING
+	TArray<FTransform> InstanceTransforms;
+	TArray<FFGPendingRocketTrace> PendingTraces;
+	TArray<TPair<AFGRocket*, AFGPlayer*>> Detonations;
+	UPROPERTY(Transient)
+	UInstancedStaticMeshComponent* InstancedMesh = nullptr;
+	FTransform MeshTransform = FTransform::Identity;
+	bool bTriedCreatingInstancedMesh = false;
+};
@@ -0,0 +1,113 @@
+#include "FGRocketPoolSubsystem.h"
+#include "Engine/World.h"
+#include "../FGRocket.h"
+
+void UFGRocketPoolSubsystem::RegisterRocket(AFGRocket* Rocket)
+{
+	if (!ensure(Rocket != nullptr) || Rockets.Contains(Rocket))
+	{
+		return;
+	}
+	Rockets.Add(Rocket);
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		Rocket->PoolIndex = RocketsByIndex.Num();
+	}
+	if (Rocket->PoolIndex >= 0)
+	{
+		if (Rocket->PoolIndex >= RocketsByIndex.Num())
+		{
+			RocketsByIndex.SetNumZeroed(Rocket->PoolIndex + 1);
+		}
+		RocketsByIndex[Rocket->PoolIndex] = Rocket;
+	}
+	if (Rocket->IsFree())
+	{
+		LinkFree(Rocket);
+	}
+}
+
+void UFGRocketPoolSubsystem::UnregisterRocket(AFGRocket* Rocket)
+{
+	if (Rockets.RemoveSwap(Rocket) > 0)
+	{
+		UnlinkFree(Rocket);
+		if (RocketsByIndex.IsValidIndex(Rocket->PoolIndex) && RocketsByIndex[Rocket->PoolIndex] == Rocket)
+		{
+			RocketsByIndex[Rocket->PoolIndex] = nullptr;
+		}
+	}
+}
+
+void UFGRocketPoolSubsystem::ClaimRocket(AFGRocket* Rocket)
+{
+	UnlinkFree(Rocket);
+}
+
+void UFGRocketPoolSubsystem::ReleaseRocket(AFGRocket* Rocket)
+{
+	LinkFree(Rocket);
+}
+
+void UFGRocketPoolSubsystem::EnsureFreeRockets(TSubclassOf<AFGRocket> RocketClass)
+{
+	UWorld* World = GetWorld();
+	if (RocketClass == nullptr || World == nullptr || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+	// Pool indices are sent as 16 bits in fire events.
+	const int32 PoolSizeLimit = FMath::Min(MaxPoolSize, static_cast<int32>(MAX_uint16));
+	while (NumberFreeRockets < MinFreeRockets && RocketsByIndex.Num() < PoolSizeLimit)
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags = RF_Transient;
+		AFGRocket* NewRocket = World->SpawnActor<AFGRocket>(RocketClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParameters);
+		if (!ensure(NewRocket != nullptr && Rockets.Contains(NewRocket)))
+		{
+			return;
+		}
+	}
+}
+
+void UFGRocketPoolSubsystem::LinkFree(AFGRocket* Rocket)
+{
+	if (Rocket->bLinkedFree)
+	{
+		return;
+	}
+	Rocket->PreviousFreeRocket = nullptr;
+	Rocket->NextFreeRocket = FreeHead;
+	if (FreeHead != nullptr)
+	{
+		FreeHead->PreviousFreeRocket = Rocket;
+	}
+	FreeHead = Rocket;
+	Rocket->bLinkedFree = true;
+	NumberFreeRockets++;
+}
+
+void UFGRocketPoolSubsystem::UnlinkFree(AFGRocket* Rocket)
+{
+	if (!Rocket->bLinkedFree)
+	{
+		return;
+	}
+	if (Rocket->PreviousFreeRocket != nullptr)
+	{
+		Rocket->PreviousFreeRocket->NextFreeRocket = Rocket->NextFreeRocket;
+	}
+	else
+	{
+		FreeHead = Rocket->NextFreeRocket;
+	}
+	if (Rocket->NextFreeRocket != nullptr)
+	{
+		Rocket->NextFreeRocket->PreviousFreeRocket = Rocket->PreviousFreeRocket;
+	}
+	Rocket->PreviousFreeRocket = nullptr;
+	Rocket->NextFreeRocket = nullptr;
+	Rocket->bLinkedFree = false;
+	NumberFreeRockets--;
+}
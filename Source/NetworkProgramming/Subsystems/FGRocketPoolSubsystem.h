@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGRocketPoolSubsystem.generated.h"
+
+class AFGRocket;
+
+UCLASS(Config = Game)
+class NETWORKPROGRAMMING_API UFGRocketPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	void RegisterRocket(AFGRocket* Rocket);
+	void UnregisterRocket(AFGRocket* Rocket);
+	void ClaimRocket(AFGRocket* Rocket);
+	void ReleaseRocket(AFGRocket* Rocket);
+	AFGRocket* GetFreeRocket() const { return FreeHead; }
+	AFGRocket* GetRocketByIndex(int32 PoolIndex) const { return RocketsByIndex.IsValidIndex(PoolIndex) ? RocketsByIndex[PoolIndex] : nullptr; }
+	void EnsureFreeRockets(TSubclassOf<AFGRocket> RocketClass);
+	int32 GetNumberRockets() const { return Rockets.Num(); }
+	int32 GetNumberFreeRockets() const { return NumberFreeRockets; }
+	int32 GetNumberActiveRockets() const { return Rockets.Num() - NumberFreeRockets; }
+private:
+	void LinkFree(AFGRocket* Rocket);
+	void UnlinkFree(AFGRocket* Rocket);
+	UPROPERTY(Config)
+	int32 MaxPoolSize = 64;
+	UPROPERTY(Config)
+	int32 MinFreeRockets = 8;
+	UPROPERTY(Transient)
+	TArray<AFGRocket*> Rockets;
+	// Indexed by AFGRocket::PoolIndex, which is the same on the server and every client.
+	UPROPERTY(Transient)
+	TArray<AFGRocket*> RocketsByIndex;
+	AFGRocket* FreeHead = nullptr;
+	int32 NumberFreeRockets = 0;
+};
@@ -0,0 +1,165 @@
+#include "Misc/AutomationTest.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "../FGPickup.h"
+#include "../Subsystems/FGPickupGridSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const uint32 PickupGridTestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+
+	// Pickups are only spawned, never begun, so the grid holds exactly what the test registers.
+	class FFGPickupGridTestWorld
+	{
+	public:
+		FFGPickupGridTestWorld()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			PickupGrid = World != nullptr ? World->GetSubsystem<UFGPickupGridSubsystem>() : nullptr;
+		}
+		~FFGPickupGridTestWorld()
+		{
+			if (World != nullptr)
+			{
+				World->DestroyWorld(false);
+			}
+		}
+		AFGPickup* AddPickup(const FVector& Location, float Radius)
+		{
+			AFGPickup* Pickup = World->SpawnActor<AFGPickup>(Location, FRotator::ZeroRotator);
+			if (Pickup != nullptr)
+			{
+				PickupGrid->RegisterPickup(Pickup, Radius);
+			}
+			return Pickup;
+		}
+		bool Gathers(const FVector& Location, float Radius, const AFGPickup* Pickup) const
+		{
+			TArray<AFGPickup*> Pickups;
+			PickupGrid->GatherPickups(Location, Radius, Pickups);
+			return Pickups.Contains(Pickup);
+		}
+		UWorld* World = nullptr;
+		UFGPickupGridSubsystem* PickupGrid = nullptr;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGPickupGridNeighbourCellsTest, "NetworkProgramming.PickupGrid.NeighbourCells", PickupGridTestFlags)
+
+bool FFGPickupGridNeighbourCellsTest::RunTest(const FString& Parameters)
+{
+	FFGPickupGridTestWorld TestWorld;
+	if (!TestNotNull(TEXT("Pickup grid"), TestWorld.PickupGrid))
+	{
+		return false;
+	}
+	const float CellSize = TestWorld.PickupGrid->GetCellSize();
+	AFGPickup* AcrossEdge = TestWorld.AddPickup(FVector(CellSize + 20.0f, 100.0f, 0.0f), 30.0f);
+	AFGPickup* AcrossCorner = TestWorld.AddPickup(FVector(CellSize + 10.0f, CellSize + 10.0f, 0.0f), 30.0f);
+	AFGPickup* AcrossOrigin = TestWorld.AddPickup(FVector(-10.0f, -10.0f, 0.0f), 30.0f);
+	if (!TestTrue(TEXT("Pickups spawned"), AcrossEdge != nullptr && AcrossCorner != nullptr && AcrossOrigin != nullptr))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Pickup in the next cell along X is found"), TestWorld.Gathers(FVector(CellSize - 20.0f, 100.0f, 0.0f), 20.0f, AcrossEdge));
+	TestTrue(TEXT("Pickup in the diagonal cell is found"), TestWorld.Gathers(FVector(CellSize - 10.0f, CellSize - 10.0f, 0.0f), 10.0f, AcrossCorner));
+	TestTrue(TEXT("Pickup in a negative cell is found from a positive one"), TestWorld.Gathers(FVector(10.0f, 10.0f, 0.0f), 10.0f, AcrossOrigin));
+	TestTrue(TEXT("Large query sphere reaches two cells over"), TestWorld.Gathers(FVector(60.0f - CellSize, 100.0f, 0.0f), 2.0f * CellSize - 10.0f, AcrossEdge));
+	TestTrue(TEXT("Touching spheres count as overlapping"), TestWorld.Gathers(FVector(CellSize - 30.0f, 100.0f, 0.0f), 20.0f, AcrossEdge));
+	TestFalse(TEXT("Spheres just apart across the edge do not"), TestWorld.Gathers(FVector(CellSize - 31.0f, 100.0f, 0.0f), 20.0f, AcrossEdge));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGPickupGridLargeRadiusTest, "NetworkProgramming.PickupGrid.LargeRadius", PickupGridTestFlags)
+
+bool FFGPickupGridLargeRadiusTest::RunTest(const FString& Parameters)
+{
+	FFGPickupGridTestWorld TestWorld;
+	if (!TestNotNull(TEXT("Pickup grid"), TestWorld.PickupGrid))
+	{
+		return false;
+	}
+	const float CellSize = TestWorld.PickupGrid->GetCellSize();
+	AFGPickup* LargePickup = TestWorld.AddPickup(FVector(2.5f * CellSize, 0.5f * CellSize, 0.0f), 2.0f * CellSize);
+	if (!TestNotNull(TEXT("Pickup spawned"), LargePickup))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Large pickup is found two cells away"), TestWorld.Gathers(FVector(0.5f * CellSize, 0.5f * CellSize, 0.0f), 10.0f, LargePickup));
+	TestFalse(TEXT("Large pickup is not found out of reach"), TestWorld.Gathers(FVector(0.5f * CellSize - 20.0f, 0.5f * CellSize, 0.0f), 10.0f, LargePickup));
+	TestTrue(TEXT("Large pickup is found two cells away on the other side"), TestWorld.Gathers(FVector(4.5f * CellSize, 0.5f * CellSize, 0.0f), 10.0f, LargePickup));
+
+	TestWorld.PickupGrid->UnregisterPickup(LargePickup);
+	TestFalse(TEXT("Unregistered pickup is not found"), TestWorld.Gathers(LargePickup->GetActorLocation(), 10.0f, LargePickup));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGPickupGridBenchmarkTest, "NetworkProgramming.PickupGrid.Benchmark", PickupGridTestFlags)
+
+// Timings only go to the log, they depend too much on the machine to assert on.
+bool FFGPickupGridBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const int32 NumberPickupsToTest[] = { 50, 200, 1000 };
+	const int32 NumberQueries = 8 * 1000;
+	const float ArenaSize = 20000.0f;
+	const float PickupRadius = 50.0f;
+	const float PlayerRadius = 50.0f;
+	for (const int32 NumberPickups : NumberPickupsToTest)
+	{
+		FFGPickupGridTestWorld TestWorld;
+		if (!TestNotNull(TEXT("Pickup grid"), TestWorld.PickupGrid))
+		{
+			return false;
+		}
+		FRandomStream Random(NumberPickups);
+		for (int32 Index = 0; Index < NumberPickups; ++Index)
+		{
+			const FVector Location(Random.FRandRange(0.0f, ArenaSize), Random.FRandRange(0.0f, ArenaSize), 0.0f);
+			AFGPickup* Pickup = TestWorld.AddPickup(Location, PickupRadius);
+			if (!TestNotNull(TEXT("Pickup spawned"), Pickup))
+			{
+				return false;
+			}
+			Pickup->SphereComponent->SetSphereRadius(PickupRadius);
+			Pickup->SphereComponent->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+		}
+		TArray<FVector> QueryLocations;
+		for (int32 Index = 0; Index < NumberQueries; ++Index)
+		{
+			QueryLocations.Add(FVector(Random.FRandRange(0.0f, ArenaSize), Random.FRandRange(0.0f, ArenaSize), 0.0f));
+		}
+
+		TArray<AFGPickup*> NearbyPickups;
+		int32 NumberGridHits = 0;
+		const double GridStartTime = FPlatformTime::Seconds();
+		for (const FVector& Location : QueryLocations)
+		{
+			TestWorld.PickupGrid->GatherPickups(Location, PlayerRadius, NearbyPickups);
+			NumberGridHits += NearbyPickups.Num();
+		}
+		const double GridTime = FPlatformTime::Seconds() - GridStartTime;
+
+		TArray<FOverlapResult> Overlaps;
+		const FCollisionObjectQueryParams ObjectParams(ECC_WorldDynamic);
+		const FCollisionShape PlayerShape = FCollisionShape::MakeSphere(PlayerRadius);
+		int32 NumberOverlapHits = 0;
+		const double OverlapStartTime = FPlatformTime::Seconds();
+		for (const FVector& Location : QueryLocations)
+		{
+			TestWorld.World->OverlapMultiByObjectType(Overlaps, Location, FQuat::Identity, ObjectParams, PlayerShape);
+			NumberOverlapHits += Overlaps.Num();
+		}
+		const double OverlapTime = FPlatformTime::Seconds() - OverlapStartTime;
+
+		AddInfo(FString::Printf(TEXT("%d pickups, %d queries: grid %.3f ms (%d hits), physics overlap %.3f ms (%d hits)."),
+			NumberPickups, NumberQueries, GridTime * 1000.0, NumberGridHits, OverlapTime * 1000.0, NumberOverlapHits));
+	}
+	return true;
+}
+
+#endif
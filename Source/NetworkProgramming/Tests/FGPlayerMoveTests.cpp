@@ -0,0 +1,164 @@
+#include "Misc/AutomationTest.h"
+#include "Engine/NetSerialization.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "../Player/FGPlayerMove.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const uint32 MovePacketTestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+	const int32 MoveBits = 8 + 8 + 8 + 1;
+	const int32 StateHeaderBits = 2 + 16 + 8;
+	const int32 StateFixedBits = 8 + 8 + 1;
+	const int32 YawBits = 16;
+
+	int64 GetElementCountBits(uint32 NumberElements)
+	{
+		FBitWriter Writer(0, true);
+		Writer.SerializeInt(NumberElements, FFGMovePacket::MaxElements + 1);
+		return Writer.GetNumBits();
+	}
+
+	int64 GetLocationDeltaBits(FVector LocationDelta)
+	{
+		FBitWriter Writer(0, true);
+		SerializePackedVector<10, 24>(LocationDelta, Writer);
+		return Writer.GetNumBits();
+	}
+
+	bool RoundTrip(FFGMovePacket& Packet, FFGMovePacket& OutPacket, int64& OutNumberBits)
+	{
+		FBitWriter Writer(0, true);
+		bool bSaved = false;
+		Packet.NetSerialize(Writer, nullptr, bSaved);
+		OutNumberBits = Writer.GetNumBits();
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		bool bLoaded = false;
+		OutPacket.NetSerialize(Reader, nullptr, bLoaded);
+		return bSaved && bLoaded && !Reader.IsError() && Reader.AtEnd();
+	}
+
+	FFGMovePacket MakeStatePacket(uint8 BaselineOffset, const FVector& BaselineLocation)
+	{
+		FFGMovePacket Packet;
+		Packet.BaseTimeStamp = 20.0f;
+		Packet.Sequence = 10;
+		Packet.BaselineOffset = BaselineOffset;
+		Packet.LocationQuantization = EFGLocationQuantization::Quantize10;
+		const float Yaws[] = { 45.0f, 45.0f, -90.0f };
+		const float TimeStamps[] = { 20.016f, 20.032f, 20.432f };
+		for (int32 Index = 0; Index < 3; ++Index)
+		{
+			FFGPlayerMoveState& State = Packet.States.AddDefaulted_GetRef();
+			State.TimeStamp = TimeStamps[Index];
+			State.Location = BaselineLocation + FVector(12.34f * (Index + 1), -5.67f * Index, 0.05f);
+			State.Yaw = Yaws[Index];
+			State.Forward = Index == 2 ? -1.0f : 0.5f;
+			State.bBrake = Index == 1;
+		}
+		Packet.QuantizeStates(BaselineLocation);
+		return Packet;
+	}
+
+	int64 GetExpectedStateBits(const FFGMovePacket& Packet, const FVector& BaselineLocation)
+	{
+		int64 NumberBits = 1 + 32 + GetElementCountBits(Packet.States.Num()) + StateHeaderBits;
+		FVector PreviousLocation = Packet.IsKeyframe() ? FVector::ZeroVector : BaselineLocation;
+		for (int32 Index = 0; Index < Packet.States.Num(); ++Index)
+		{
+			const FFGPlayerMoveState& State = Packet.States[Index];
+			NumberBits += StateFixedBits + GetLocationDeltaBits(FFGMovePacket::QuantizeLocation(State.Location - PreviousLocation, Packet.LocationQuantization));
+			PreviousLocation = State.Location;
+			if (Index == 0)
+			{
+				NumberBits += YawBits;
+			}
+			else
+			{
+				NumberBits += 1 + (State.Yaw != Packet.States[Index - 1].Yaw ? YawBits : 0);
+			}
+		}
+		return NumberBits;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGMovePacketMovesTest, "NetworkProgramming.MovePacket.Moves", MovePacketTestFlags)
+
+bool FFGMovePacketMovesTest::RunTest(const FString& Parameters)
+{
+	FFGMovePacket Packet;
+	Packet.BaseTimeStamp = 10.0f;
+	FFGPlayerMove& FirstMove = Packet.Moves.AddDefaulted_GetRef();
+	FirstMove.TimeStamp = 10.016f;
+	FirstMove.DeltaTime = 0.016f;
+	FirstMove.Forward = 1.0f;
+	FirstMove.Turn = -0.5f;
+	FirstMove.bBrake = true;
+	FFGPlayerMove& SecondMove = Packet.Moves.AddDefaulted_GetRef();
+	SecondMove.TimeStamp = 10.316f;
+	SecondMove.DeltaTime = 0.3f;
+	SecondMove.Forward = -0.25f;
+
+	FFGMovePacket Received;
+	int64 NumberBits = 0;
+	TestTrue(TEXT("Round trip succeeds"), RoundTrip(Packet, Received, NumberBits));
+	TestEqual(TEXT("Bit count"), NumberBits, 1 + 32 + GetElementCountBits(2) + 2 * MoveBits);
+	if (!TestEqual(TEXT("Number of moves"), Received.Moves.Num(), 2))
+	{
+		return false;
+	}
+	TestEqual(TEXT("First time stamp"), Received.Moves[0].TimeStamp, 10.016f, 0.0005f);
+	TestEqual(TEXT("First delta time"), Received.Moves[0].DeltaTime, 0.016f, 0.0005f);
+	TestEqual(TEXT("First forward"), Received.Moves[0].Forward, 1.0f);
+	TestEqual(TEXT("First turn"), Received.Moves[0].Turn, FFGMovePacket::QuantizeAxis(-0.5f));
+	TestTrue(TEXT("First brake"), Received.Moves[0].bBrake);
+	// 300 ms between moves is clamped to the 255 ms a byte holds, and the move itself to the longest move.
+	TestEqual(TEXT("Clamped time stamp"), Received.Moves[1].TimeStamp, 10.016f + 0.255f, 0.0005f);
+	TestEqual(TEXT("Clamped delta time"), Received.Moves[1].DeltaTime, FFGMovePacket::MaxDeltaTimeMs / 1000.0f, 0.0005f);
+	TestEqual(TEXT("Second forward"), Received.Moves[1].Forward, FFGMovePacket::QuantizeAxis(-0.25f));
+	TestFalse(TEXT("Second brake"), Received.Moves[1].bBrake);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGMovePacketStatesTest, "NetworkProgramming.MovePacket.States", MovePacketTestFlags)
+
+bool FFGMovePacketStatesTest::RunTest(const FString& Parameters)
+{
+	const FVector BaselineLocation(1000.0f, -2000.0f, 50.0f);
+	FFGMovePacket Keyframe = MakeStatePacket(0, BaselineLocation);
+	FFGMovePacket Delta = MakeStatePacket(2, BaselineLocation);
+	FFGMovePacket* Packets[] = { &Keyframe, &Delta };
+	int64 PacketBits[2] = { 0, 0 };
+	for (int32 PacketIndex = 0; PacketIndex < 2; ++PacketIndex)
+	{
+		FFGMovePacket& Packet = *Packets[PacketIndex];
+		const TCHAR* Name = Packet.IsKeyframe() ? TEXT("Keyframe") : TEXT("Delta");
+		FFGMovePacket Received;
+		TestTrue(*FString::Printf(TEXT("%s round trip succeeds"), Name), RoundTrip(Packet, Received, PacketBits[PacketIndex]));
+		TestEqual(*FString::Printf(TEXT("%s bit count"), Name), PacketBits[PacketIndex], GetExpectedStateBits(Packet, BaselineLocation));
+		if (!TestEqual(*FString::Printf(TEXT("%s number of states"), Name), Received.States.Num(), Packet.States.Num()))
+		{
+			continue;
+		}
+		TestEqual(*FString::Printf(TEXT("%s sequence"), Name), Received.Sequence, Packet.Sequence);
+		TestEqual(*FString::Printf(TEXT("%s baseline sequence"), Name), Received.GetBaselineSequence(), Packet.GetBaselineSequence());
+		Received.ResolveStates(BaselineLocation);
+		for (int32 Index = 0; Index < Packet.States.Num(); ++Index)
+		{
+			const FFGPlayerMoveState& Sent = Packet.States[Index];
+			const FFGPlayerMoveState& State = Received.States[Index];
+			TestEqual(*FString::Printf(TEXT("%s location %d"), Name, Index), State.Location, Sent.Location, 0.001f);
+			TestEqual(*FString::Printf(TEXT("%s yaw %d"), Name, Index), State.Yaw, Sent.Yaw, 0.001f);
+			TestEqual(*FString::Printf(TEXT("%s forward %d"), Name, Index), State.Forward, Sent.Forward);
+			TestEqual(*FString::Printf(TEXT("%s brake %d"), Name, Index), State.bBrake, Sent.bBrake);
+		}
+		TestEqual(*FString::Printf(TEXT("%s second time stamp"), Name), Received.States[1].TimeStamp, 20.032f, 0.0005f);
+		TestEqual(*FString::Printf(TEXT("%s clamped time stamp"), Name), Received.States[2].TimeStamp, 20.032f + 0.255f, 0.0005f);
+	}
+	TestTrue(TEXT("Delta is smaller than keyframe"), PacketBits[1] < PacketBits[0]);
+	return true;
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "Misc/AutomationTest.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Engine/World.h"
+#include "UObject/UnrealType.h"
+#include "../Components/Replicator/FGReplicatedValues.h"
+#include "../Components/Replicator/FGVectorReplicator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const uint32 ReplicatedValuesTestFlags = EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter;
+	const int32 NumberSamples = 300;
+	const float SampleInterval = 1.0f / 30.0f;
+
+	// A value that drifts for the first half and rests for the second, with sensor noise on top the whole time.
+	void MakeNoisyInput(TArray<FVector>& OutSamples)
+	{
+		FRandomStream Random(1234);
+		OutSamples.Reset(NumberSamples);
+		for (int32 Index = 0; Index < NumberSamples; ++Index)
+		{
+			const float Time = FMath::Min(Index, NumberSamples / 2) * SampleInterval;
+			const FVector Signal(Time * 10.0f, FMath::Sin(Time * 0.2f) * 20.0f, 20.0f);
+			const FVector Noise(Random.FRandRange(-0.05f, 0.05f), Random.FRandRange(-0.05f, 0.05f), Random.FRandRange(-0.05f, 0.05f));
+			OutSamples.Add(Signal + Noise);
+		}
+	}
+
+	struct FFGSendResult
+	{
+		int32 NumberSends = 0;
+		int64 NumberBits = 0;
+	};
+
+	bool RunReplicator(AActor* Owner, const TArray<FVector>& Samples, const FFGQuantizationPolicy& Policy, float Deadband, FFGSendResult& OutResult)
+	{
+		// Quantization is only meant to be set on class defaults, set it the way the details panel would.
+		FStructProperty* QuantizationProperty = FindFProperty<FStructProperty>(UFGReplicatorBase::StaticClass(), TEXT("Quantization"));
+		if (QuantizationProperty == nullptr)
+		{
+			return false;
+		}
+		UFGVectorReplicator* Replicator = NewObject<UFGVectorReplicator>(Owner);
+		*QuantizationProperty->ContainerPtrToValuePtr<FFGQuantizationPolicy>(Replicator) = Policy;
+		Replicator->Deadband = Deadband;
+		Replicator->Init();
+		FBitWriter Writer(0, true);
+		OutResult = FFGSendResult();
+		for (const FVector& Sample : Samples)
+		{
+			Replicator->SetValue(Sample);
+			Replicator->Tick(SampleInterval);
+			if (Replicator->GatherSend(true) != EFGReplicatorSendType::None)
+			{
+				Replicator->WriteValue(Writer);
+				OutResult.NumberSends++;
+			}
+		}
+		OutResult.NumberBits = Writer.GetNumBits();
+		Replicator->MarkPendingKill();
+		return true;
+	}
+
+	bool RoundTrip(const FVector& Value, const FFGQuantizationPolicy& Policy, FVector& OutValue, int64& OutNumberBits)
+	{
+		FBitWriter Writer(0, true);
+		FVector SentValue = Value;
+		TFGReplicatedValueTraits<FVector>::NetSerialize(Writer, SentValue, Policy);
+		OutNumberBits = Writer.GetNumBits();
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		OutValue = FVector::ZeroVector;
+		TFGReplicatedValueTraits<FVector>::NetSerialize(Reader, OutValue, Policy);
+		return !Reader.IsError() && Reader.AtEnd();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGReplicatedValuesNoisyBandwidthTest, "NetworkProgramming.ReplicatedValues.NoisyInputBandwidth", ReplicatedValuesTestFlags)
+
+bool FFGReplicatedValuesNoisyBandwidthTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	AActor* Owner = World != nullptr ? World->SpawnActor<AActor>() : nullptr;
+	if (!TestNotNull(TEXT("Replicator owner"), Owner))
+	{
+		return false;
+	}
+	TArray<FVector> Samples;
+	MakeNoisyInput(Samples);
+	FFGQuantizationPolicy DefaultPolicy;
+	FFGQuantizationPolicy StepPolicy;
+	StepPolicy.Mode = EFGQuantizationMode::Step;
+	StepPolicy.Step = 1.0f;
+	FFGQuantizationPolicy RangePolicy;
+	RangePolicy.Mode = EFGQuantizationMode::Range;
+	RangePolicy.Min = -64.0f;
+	RangePolicy.Max = 64.0f;
+	RangePolicy.NumberBits = 10;
+	const float Deadband = 1.0f;
+
+	FFGSendResult Default;
+	FFGSendResult Step;
+	FFGSendResult Range;
+	FFGSendResult DefaultDeadband;
+	FFGSendResult StepDeadband;
+	const bool bRan = RunReplicator(Owner, Samples, DefaultPolicy, 0.0f, Default) && RunReplicator(Owner, Samples, StepPolicy, 0.0f, Step)
+		&& RunReplicator(Owner, Samples, RangePolicy, 0.0f, Range) && RunReplicator(Owner, Samples, DefaultPolicy, Deadband, DefaultDeadband)
+		&& RunReplicator(Owner, Samples, StepPolicy, Deadband, StepDeadband);
+	World->DestroyWorld(false);
+	if (!TestTrue(TEXT("Replicators ran"), bRan))
+	{
+		return false;
+	}
+	AddInfo(FString::Printf(TEXT("Quantization, every sample sent: default %lld bits, step %lld bits (%.0f%%), range %lld bits (%.0f%%)."),
+		Default.NumberBits, Step.NumberBits, 100.0 * Step.NumberBits / Default.NumberBits, Range.NumberBits, 100.0 * Range.NumberBits / Default.NumberBits));
+	AddInfo(FString::Printf(TEXT("Deadband, default format: %d of %d sends, %lld bits (%.0f%%)."),
+		DefaultDeadband.NumberSends, Default.NumberSends, DefaultDeadband.NumberBits, 100.0 * DefaultDeadband.NumberBits / Default.NumberBits));
+	AddInfo(FString::Printf(TEXT("Both: %d sends, %lld bits (%.0f%%)."), StepDeadband.NumberSends, StepDeadband.NumberBits, 100.0 * StepDeadband.NumberBits / Default.NumberBits));
+
+	TestEqual(TEXT("Without a deadband every noisy sample is sent"), Default.NumberSends, NumberSamples);
+	TestEqual(TEXT("Quantization does not change what is sent"), Step.NumberSends, Default.NumberSends);
+	TestEqual(TEXT("Range values use a fixed number of bits"), Range.NumberBits, static_cast<int64>(Range.NumberSends) * 3 * RangePolicy.NumberBits);
+	TestTrue(TEXT("Step quantization saves bits on every send"), Step.NumberBits < Default.NumberBits);
+	TestTrue(TEXT("Range quantization saves bits on every send"), Range.NumberBits < Default.NumberBits);
+	TestTrue(TEXT("The deadband skips samples that only differ by noise"), DefaultDeadband.NumberSends < NumberSamples / 3);
+	TestEqual(TEXT("The deadband decides on the raw value, whatever the format"), StepDeadband.NumberSends, DefaultDeadband.NumberSends);
+	TestTrue(TEXT("Both savings add up"), StepDeadband.NumberBits < DefaultDeadband.NumberBits && StepDeadband.NumberBits < Step.NumberBits);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFGReplicatedValuesQuantizationErrorTest, "NetworkProgramming.ReplicatedValues.QuantizationError", ReplicatedValuesTestFlags)
+
+bool FFGReplicatedValuesQuantizationErrorTest::RunTest(const FString& Parameters)
+{
+	TArray<FVector> Samples;
+	MakeNoisyInput(Samples);
+	FFGQuantizationPolicy StepPolicy;
+	StepPolicy.Mode = EFGQuantizationMode::Step;
+	StepPolicy.Step = 0.1f;
+	FFGQuantizationPolicy RangePolicy;
+	RangePolicy.Mode = EFGQuantizationMode::Range;
+	RangePolicy.Min = -1024.0f;
+	RangePolicy.Max = 1024.0f;
+	RangePolicy.NumberBits = 16;
+	const float RangeResolution = (RangePolicy.Max - RangePolicy.Min) / static_cast<float>((1 << RangePolicy.NumberBits) - 1);
+	// Half a quantization step, plus float rounding at these magnitudes.
+	const float Tolerance = 0.001f;
+
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		FVector Received;
+		int64 NumberBits = 0;
+		if (!TestTrue(*FString::Printf(TEXT("Step round trip %d"), Index), RoundTrip(Samples[Index], StepPolicy, Received, NumberBits)))
+		{
+			return false;
+		}
+		TestTrue(*FString::Printf(TEXT("Step error %d"), Index), Samples[Index].Equals(Received, StepPolicy.Step * 0.5f + Tolerance));
+		if (!TestTrue(*FString::Printf(TEXT("Range round trip %d"), Index), RoundTrip(Samples[Index], RangePolicy, Received, NumberBits)))
+		{
+			return false;
+		}
+		TestTrue(*FString::Printf(TEXT("Range error %d"), Index), Samples[Index].Equals(Received, RangeResolution * 0.5f + Tolerance));
+	}
+
+	FVector Received;
+	int64 NumberBits = 0;
+	TestTrue(TEXT("Out of range round trip"), RoundTrip(FVector(5000.0f, -5000.0f, 0.0f), RangePolicy, Received, NumberBits));
+	TestEqual(TEXT("Clamped to the range"), Received, FVector(RangePolicy.Max, RangePolicy.Min, Received.Z));
+	return true;
+}
+
+#endif